@@ -0,0 +1,141 @@
+/*
+ File: BufferedWriter.cpp
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <BufferedWriter.h>
+
+// C++
+#include <algorithm>
+#include <cstring>
+
+// zlib
+#include <zlib.h>
+
+constexpr size_t COMPRESSED_SIZE = 1 << 18;
+
+//-----------------------------------------------------------------
+BufferedWriter::BufferedWriter(const QString &filename, const bool append, const int compression, const size_t capacity)
+: m_file{filename}
+, m_buffer(std::max<size_t>(capacity, 1))
+{
+    // the buffer is ours, the device doesn't need another one.
+    const auto mode = append ? QIODevice::Append : QIODevice::Truncate;
+    if (!m_file.open(QIODevice::WriteOnly | mode | QIODevice::Unbuffered)) {
+        m_error = true;
+        return;
+    }
+
+    if (compression > 0) {
+        // 16 added to the window bits writes a gzip header and trailer instead of a zlib one.
+        m_stream = std::make_unique<z_stream_s>();
+        if (deflateInit2(m_stream.get(), std::min(compression, 9), Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            m_stream.reset();
+            m_error = true;
+            return;
+        }
+        m_compressed.resize(COMPRESSED_SIZE);
+    }
+}
+
+//-----------------------------------------------------------------
+BufferedWriter::~BufferedWriter()
+{
+    close();
+}
+
+//-----------------------------------------------------------------
+void BufferedWriter::write(const std::string_view text)
+{
+    if (m_size + text.size() > m_buffer.size()) {
+        flush();
+
+        // texts bigger than the buffer are written directly.
+        if (text.size() > m_buffer.size()) {
+            output(text.data(), text.size());
+            return;
+        }
+    }
+
+    std::memcpy(m_buffer.data() + m_size, text.data(), text.size());
+    m_size += text.size();
+}
+
+//-----------------------------------------------------------------
+void BufferedWriter::write(const char c)
+{
+    if (m_size == m_buffer.size()) flush();
+
+    m_buffer[m_size++] = c;
+}
+
+//-----------------------------------------------------------------
+bool BufferedWriter::close()
+{
+    if (!m_file.isOpen()) return !m_error;
+
+    if (m_stream) {
+        output(m_buffer.data(), m_size, true);
+        m_size = 0;
+        deflateEnd(m_stream.get());
+        m_stream.reset();
+    } else {
+        flush();
+    }
+    m_file.close();
+
+    return !m_error;
+}
+
+//-----------------------------------------------------------------
+void BufferedWriter::flush()
+{
+    if (m_size == 0) return;
+
+    output(m_buffer.data(), m_size);
+    m_size = 0;
+}
+
+//-----------------------------------------------------------------
+void BufferedWriter::output(const char *data, const size_t size, const bool finish)
+{
+    if (m_error) return;
+
+    if (!m_stream) {
+        if (m_file.write(data, size) != static_cast<qint64>(size)) m_error = true;
+        return;
+    }
+
+    // the stream doesn't modify the input, but zlib's interface isn't const.
+    m_stream->next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+    m_stream->avail_in = static_cast<uInt>(size);
+    do {
+        m_stream->next_out = reinterpret_cast<Bytef *>(m_compressed.data());
+        m_stream->avail_out = static_cast<uInt>(m_compressed.size());
+        if (deflate(m_stream.get(), finish ? Z_FINISH : Z_NO_FLUSH) == Z_STREAM_ERROR) {
+            m_error = true;
+            return;
+        }
+
+        const auto compressed = static_cast<qint64>(m_compressed.size() - m_stream->avail_out);
+        if (m_file.write(m_compressed.data(), compressed) != compressed) {
+            m_error = true;
+            return;
+        }
+    } while (m_stream->avail_out == 0);
+}
@@ -0,0 +1,105 @@
+/*
+ File: BufferedWriter.h
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BUFFERED_WRITER_H_
+#define _BUFFERED_WRITER_H_
+
+// Qt
+#include <QFile>
+
+// C++
+#include <memory>
+#include <string_view>
+#include <vector>
+
+struct z_stream_s;
+
+/** \class BufferedWriter
+ * \brief Writes to a file through a large buffer, so the file is written in big blocks instead
+ *        of once per line. The buffer is allocated once. Optionally the file is compressed in
+ *        gzip format as it's written, appending to a compressed file adds a gzip member to it.
+ *
+ */
+class BufferedWriter
+{
+  public:
+    /** \brief BufferedWriter class constructor.
+     * \param[in] filename Filename of the file on disk.
+     * \param[in] append True to write at the end of the file if it exists and false to truncate it.
+     * \param[in] compression Gzip compression level in [1,9], 0 to write the file uncompressed.
+     * \param[in] capacity Size of the buffer in bytes.
+     *
+     */
+    explicit BufferedWriter(const QString &filename, const bool append = false, const int compression = 0,
+                            const size_t capacity = 1 << 20);
+
+    /** \brief BufferedWriter class destructor. Writes the buffer and closes the file.
+     *
+     */
+    ~BufferedWriter();
+
+    BufferedWriter(const BufferedWriter &) = delete;
+    BufferedWriter &operator=(const BufferedWriter &) = delete;
+
+    /** \brief Returns true if the file is open and there has been no errors.
+     *
+     */
+    bool isValid() const
+    { return m_file.isOpen() && !m_error; }
+
+    /** \brief Appends the given text to the file.
+     * \param[in] text Text to write.
+     *
+     */
+    void write(const std::string_view text);
+
+    /** \brief Appends the given character to the file.
+     * \param[in] c Character to write.
+     *
+     */
+    void write(const char c);
+
+    /** \brief Writes the buffer and closes the file. Returns true on success.
+     *
+     */
+    bool close();
+
+  private:
+    /** \brief Writes the contents of the buffer to the file.
+     *
+     */
+    void flush();
+
+    /** \brief Writes the given bytes to the file, compressing them if needed.
+     * \param[in] data Bytes to write.
+     * \param[in] size Number of bytes.
+     * \param[in] finish True to end the compressed stream after the bytes.
+     *
+     */
+    void output(const char *data, const size_t size, const bool finish = false);
+
+    QFile m_file;                         /** output file. */
+    std::vector<char> m_buffer;           /** pending bytes. */
+    size_t m_size = 0;                    /** number of pending bytes. */
+    bool m_error = false;                 /** true if a write failed. */
+    std::unique_ptr<z_stream_s> m_stream; /** compression stream, null if the file isn't compressed. */
+    std::vector<char> m_compressed;       /** compressed bytes. */
+};
+
+#endif // _BUFFERED_WRITER_H_
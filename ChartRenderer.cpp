@@ -0,0 +1,168 @@
+/*
+ File: ChartRenderer.cpp
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <ChartRenderer.h>
+#include <ChartsContents.h>
+#include <PieChart.h>
+
+// Qt
+#include <QChart>
+#include <QCoreApplication>
+#include <QDir>
+#include <QGraphicsLayout>
+#include <QGraphicsScene>
+#include <QImage>
+#include <QPainter>
+#include <QSvgGenerator>
+#include <QtConcurrent>
+
+// C++
+#include <algorithm>
+
+//----------------------------------------------------------------------------
+ChartRenderer::ChartRenderer(Utils::Configuration &config, const QSize &size)
+: m_configuration{config}
+, m_size{size}
+{
+}
+
+//----------------------------------------------------------------------------
+std::vector<ChartRenderer::Range> ChartRenderer::ranges(const QDate &from, const QDate &to, const Utils::Granularity step)
+{
+    std::vector<Range> result;
+    if(!from.isValid() || !to.isValid() || from > to) return result;
+
+    if(step == Utils::Granularity::AUTO)
+    {
+        result.push_back(Range{QDateTime{from, QTime{0, 0, 0}}, QDateTime{to, QTime{23, 59, 59}}});
+        return result;
+    }
+
+    for(auto date = from; date <= to;)
+    {
+        const auto next = Utils::nextBucket(date, step);
+        const auto last = std::min(next.addDays(-1), to);
+        result.push_back(Range{QDateTime{date, QTime{0, 0, 0}}, QDateTime{last, QTime{23, 59, 59}}});
+        date = next;
+    }
+
+    return result;
+}
+
+//----------------------------------------------------------------------------
+bool ChartRenderer::render(const std::vector<Range> &ranges, const QString &directory, const QString &format)
+{
+    m_error.clear();
+
+    const QDir dir{directory};
+    if(!dir.exists() && !QDir().mkpath(directory))
+    {
+        m_error = QString("Unable to create directory '%1'.").arg(directory);
+        return false;
+    }
+
+    // database queries and chart values don't need the charts, all ranges are prepared at once.
+    const auto &config = m_configuration;
+    const auto contents = QtConcurrent::blockingMapped<std::vector<ChartsContents>>(ranges, [config](const Range &range)
+    {
+        auto rangeConfig = config;
+        const auto granularity = Utils::histogramGranularity(range.from, range.to);
+        const auto units = Utils::taskHistogram(range.from, range.to, rangeConfig, granularity);
+        return ChartsContents::build(range.from, range.to, granularity, units, ChartsContents::totals(units),
+                                     static_cast<size_t>(config.m_chartTasks));
+    });
+
+    // the scenes own the charts, which are updated in place for each range.
+    QGraphicsScene pieScene, histogramScene;
+    auto pie = ChartsContents::createPieChart();
+    auto histogram = ChartsContents::createHistogramChart();
+    pieScene.addItem(pie);
+    histogramScene.addItem(histogram);
+    for(auto chart: {static_cast<QChart *>(pie), static_cast<QChart *>(histogram)})
+    {
+        chart->setAnimationOptions(QChart::NoAnimation);
+        chart->setBackgroundVisible(true);
+        chart->resize(m_size);
+    }
+
+    for(size_t i = 0; i < ranges.size(); ++i)
+    {
+        if(contents[i].isEmpty()) continue;
+
+        contents[i].apply(pie);
+        contents[i].apply(histogram);
+
+        const auto suffix = QString("%1_%2.%3").arg(ranges[i].from.toString("yyyyMMdd"))
+                                               .arg(ranges[i].to.toString("yyyyMMdd"))
+                                               .arg(format);
+        if(!write(pie, dir.absoluteFilePath("pie_" + suffix), format) ||
+           !write(histogram, dir.absoluteFilePath("histogram_" + suffix), format))
+            return false;
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------
+bool ChartRenderer::write(QChart *chart, const QString &filename, const QString &format)
+{
+    const QRectF rect{QPointF{0, 0}, QSizeF{m_size}};
+
+    // without a view the layout requests aren't processed until the events are.
+    QCoreApplication::processEvents();
+    chart->layout()->activate();
+
+    if(format == "svg")
+    {
+        QSvgGenerator generator;
+        generator.setFileName(filename);
+        generator.setSize(m_size);
+        generator.setViewBox(rect);
+        generator.setTitle(chart->title());
+
+        QPainter painter;
+        if(!painter.begin(&generator))
+        {
+            m_error = QString("Unable to write file '%1'.").arg(filename);
+            return false;
+        }
+        painter.setRenderHint(QPainter::Antialiasing);
+        chart->scene()->render(&painter, rect, chart->sceneBoundingRect());
+        painter.end();
+
+        return true;
+    }
+
+    QImage image{m_size, QImage::Format_ARGB32_Premultiplied};
+    image.fill(Qt::white);
+
+    QPainter painter{&image};
+    painter.setRenderHint(QPainter::Antialiasing);
+    chart->scene()->render(&painter, rect, chart->sceneBoundingRect());
+    painter.end();
+
+    if(!image.save(filename, "PNG"))
+    {
+        m_error = QString("Unable to write file '%1'.").arg(filename);
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,103 @@
+/*
+ File: ChartRenderer.h
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _CHART_RENDERER_H_
+#define _CHART_RENDERER_H_
+
+// Project
+#include <Utils.h>
+
+// Qt
+#include <QDateTime>
+#include <QSize>
+#include <QString>
+
+// C++
+#include <vector>
+
+class QChart;
+
+/** \class ChartRenderer
+ * \brief Renders the pie and histogram charts of a list of ranges to image files without showing
+ *        any window. The data of all the ranges is prepared in parallel and the charts, which can
+ *        only be used in the GUI thread, are reused to render each range.
+ *
+ */
+class ChartRenderer
+{
+  public:
+    /** \struct Range
+     * \brief Range of days of a pair of charts.
+     */
+    struct Range
+    {
+        QDateTime from; /** start of the first day. */
+        QDateTime to;   /** end of the last day. */
+    };
+
+    /** \brief ChartRenderer class constructor.
+     * \param[in] config Application configuration that contains the database handle.
+     * \param[in] size Size of the images in pixels.
+     *
+     */
+    ChartRenderer(Utils::Configuration &config, const QSize &size);
+
+    /** \brief ChartRenderer class destructor.
+     *
+     */
+    ~ChartRenderer()
+    {};
+
+    /** \brief Returns the consecutive ranges of the given step between the given dates.
+     * \param[in] from Start date.
+     * \param[in] to End date.
+     * \param[in] step Length of each range, AUTO to return a single range.
+     *
+     */
+    static std::vector<Range> ranges(const QDate &from, const QDate &to, const Utils::Granularity step);
+
+    /** \brief Renders the charts of the given ranges to files in the given directory. Returns true on success.
+     * \param[in] ranges Ranges to render.
+     * \param[in] directory Output directory.
+     * \param[in] format File format, "png" or "svg".
+     *
+     */
+    bool render(const std::vector<Range> &ranges, const QString &directory, const QString &format);
+
+    /** \brief Returns the description of the last error.
+     *
+     */
+    const QString &error() const
+    { return m_error; }
+
+  private:
+    /** \brief Writes the chart to the given file. Returns true on success.
+     * \param[in] chart Chart to write.
+     * \param[in] filename Filename of the file on disk.
+     * \param[in] format File format, "png" or "svg".
+     *
+     */
+    bool write(QChart *chart, const QString &filename, const QString &format);
+
+    Utils::Configuration &m_configuration; /** application configuration. */
+    const QSize m_size;                    /** size of the images. */
+    QString m_error;                       /** description of the last error. */
+};
+
+#endif // _CHART_RENDERER_H_
@@ -0,0 +1,309 @@
+/*
+ File: ChartsContents.cpp
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <ChartsContents.h>
+#include <PieChart.h>
+#include <DayTable.h>
+
+// Qt
+#include <QLegend>
+
+// C++
+#include <algorithm>
+#include <functional>
+
+const QString OTHER_TASKS = "Other tasks";
+const QColor WORK_COLOR = QColor(79, 112, 88);
+const QColor REST_COLOR = QColor(79, 87, 112);
+
+//----------------------------------------------------------------------------
+ChartsContents ChartsContents::build(const QDateTime &from, const QDateTime &to, const Utils::Granularity granularity,
+                                     const Utils::TaskHistogram &units, const std::map<QString, unsigned long long> &totals,
+                                     const size_t shownTasks)
+{
+    ChartsContents contents;
+    if(units.empty()) return contents;
+
+    // Pie chart
+    auto &times = contents.m_times;
+    for (const auto &[name, durationMs]: totals) {
+        contents.m_totalMs += durationMs;
+        times[chartTaskName(name)] += durationMs;
+    }
+
+    // tasks out of the top are grouped, the group isn't a task so it isn't keyed by a name.
+    contents.m_shown = topTasks(times, shownTasks);
+    auto isGrouped = [&shown = contents.m_shown](const QString &name)
+    {
+        return name != Utils::LONG_BREAK && name != Utils::SHORT_BREAK && shown.find(name) == shown.cend();
+    };
+
+    qreal otherSeconds = 0;
+    bool hasOther = false;
+    for(const auto &[name, duration]: times)
+    {
+        if(isGrouped(name))
+        {
+            otherSeconds += duration / 1000;
+            hasOther = true;
+            continue;
+        }
+
+        auto &slices = (name == Utils::LONG_BREAK || name == Utils::SHORT_BREAK) ? contents.m_restSlices : contents.m_workSlices;
+        slices.push_back(PieChart::Slice{name, Utils::toCamelCase(name), static_cast<qreal>(duration / 1000)});
+    }
+    if(hasOther) contents.m_workSlices.push_back(PieChart::Slice{QString(), Utils::toCamelCase(OTHER_TASKS), otherSeconds, true});
+
+    contents.m_range = from.toString("dd/MM") + " to " + to.toString("dd/MM");
+    contents.m_end = DayTable{to.date(), to.date()}.start(to.date().toJulianDay() + 1);
+    contents.m_title = contents.m_range + QString(" - Total time: %1").arg(Utils::durationToString(contents.m_totalMs));
+
+    // Histogram chart, dense values of each bar set filled in a single pass.
+    std::map<QString, QList<qreal>> values;
+    QList<qreal> otherValues;
+    std::map<QString, QList<qreal> *> columns;
+    contents.m_categories.reserve(units.size());
+    contents.m_buckets.reserve(units.size());
+    qsizetype pos = 0;
+    for (const auto &[t, tasks]: units) {
+        contents.m_categories << bucketLabel(QDateTime::fromMSecsSinceEpoch(t), granularity);
+        contents.m_buckets.push_back(t);
+
+        for (const auto& unit : tasks) {
+            auto &column = columns[unit.name];
+            if(!column)
+            {
+                const auto name = chartTaskName(unit.name);
+                column = isGrouped(name) ? &otherValues : &values[name];
+                if(column->isEmpty()) column->resize(units.size(), 0);
+            }
+            (*column)[pos] += static_cast<qreal>(unit.durationMs) / 3600000;
+        }
+        ++pos;
+    }
+    contents.m_categoriesTitle = bucketTitle(granularity);
+
+    // order matters, grouped tasks and breaks on top.
+    for(auto &[name, barValues]: values)
+    {
+        if(name == Utils::SHORT_BREAK || name == Utils::LONG_BREAK) continue;
+        contents.m_bars.push_back(HistogramChart::Bars{name, Utils::toCamelCase(name), WORK_COLOR, std::move(barValues)});
+    }
+    if(!otherValues.isEmpty())
+        contents.m_bars.push_back(HistogramChart::Bars{QString(), Utils::toCamelCase(OTHER_TASKS), WORK_COLOR.darker(), std::move(otherValues), true});
+    for(const auto &name: {Utils::SHORT_BREAK, Utils::LONG_BREAK})
+    {
+        const auto it = values.find(name);
+        if(it == values.end()) continue;
+
+        const auto color = name == Utils::LONG_BREAK ? REST_COLOR : REST_COLOR.lighter();
+        contents.m_bars.push_back(HistogramChart::Bars{name, Utils::toCamelCase(name), color, std::move(it->second)});
+    }
+
+    return contents;
+}
+
+//----------------------------------------------------------------------------
+std::map<QString, unsigned long long> ChartsContents::totals(const Utils::TaskHistogram &units)
+{
+    std::map<QString, unsigned long long> result;
+    for(const auto &[t, tasks]: units)
+    {
+        for(const auto &unit: tasks) result[unit.name] += unit.durationMs;
+    }
+
+    return result;
+}
+
+//----------------------------------------------------------------------------
+PieChart *ChartsContents::createPieChart()
+{
+    QFont titleFont("Arial", 14);
+    titleFont.setBold(true);
+
+    auto chart = new PieChart();
+    chart->setTitleFont(titleFont);
+    chart->setBackgroundVisible(false);
+    chart->legend()->setAlignment(Qt::AlignRight);
+
+    for(const auto &[name, color]: {std::make_pair(QString("Rest"), REST_COLOR), std::make_pair(QString("Work"), WORK_COLOR)})
+    {
+        auto series = new QPieSeries();
+        series->setName(name);
+        chart->addBreakdownSeries(series, color);
+    }
+
+    return chart;
+}
+
+//----------------------------------------------------------------------------
+HistogramChart *ChartsContents::createHistogramChart()
+{
+    QFont titleFont("Arial", 14);
+    titleFont.setBold(true);
+
+    auto chart = new HistogramChart();
+    chart->setTitleFont(titleFont);
+    chart->setBackgroundVisible(false);
+    chart->legend()->setVisible(true);
+    chart->legend()->setAlignment(Qt::AlignRight);
+
+    return chart;
+}
+
+//----------------------------------------------------------------------------
+bool ChartsContents::isOtherTasks(const QPieSlice *slice)
+{
+    return PieChart::isGrouped(slice);
+}
+
+//----------------------------------------------------------------------------
+bool ChartsContents::isOtherTasks(const QBarSet *barset)
+{
+    return HistogramChart::isGrouped(barset);
+}
+
+//----------------------------------------------------------------------------
+bool ChartsContents::add(const QString &name, const unsigned long long timeMs, const unsigned long long durationMs)
+{
+    if(durationMs == 0) return true;
+    if(m_buckets.empty() || timeMs < m_buckets.front() || timeMs >= m_end) return false;
+
+    const auto taskName = chartTaskName(name);
+    const auto time = m_times.find(taskName);
+    if(time == m_times.end()) return false;
+
+    const auto isBreak = (taskName == Utils::SHORT_BREAK || taskName == Utils::LONG_BREAK);
+    const auto shown = isBreak || m_shown.find(taskName) != m_shown.cend();
+
+    // a grouped task with more time than a shown one changes the top tasks.
+    if(!shown)
+    {
+        for(const auto &shownName: m_shown)
+        {
+            if(m_times[shownName] < time->second + durationMs) return false;
+        }
+    }
+
+    // the grouped tasks have no key.
+    const auto key = shown ? taskName : QString();
+    const auto bar = std::find_if(m_bars.begin(), m_bars.end(), [&](const auto &bars) { return bars.key == key && bars.grouped == !shown; });
+    if(bar == m_bars.end()) return false;
+
+    auto &slices = isBreak ? m_restSlices : m_workSlices;
+    const auto slice = std::find_if(slices.begin(), slices.end(), [&](const auto &s) { return s.key == key && s.grouped == !shown; });
+    if(slice == slices.end()) return false;
+
+    const auto bucket = std::upper_bound(m_buckets.cbegin(), m_buckets.cend(), timeMs) - m_buckets.cbegin() - 1;
+    bar->values[bucket] += static_cast<qreal>(durationMs) / 3600000;
+
+    // slices are the sum of the seconds of each task.
+    slice->value += static_cast<qreal>((time->second + durationMs) / 1000) - static_cast<qreal>(time->second / 1000);
+
+    time->second += durationMs;
+    m_totalMs += durationMs;
+    m_title = m_range + QString(" - Total time: %1").arg(Utils::durationToString(m_totalMs));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------
+void ChartsContents::apply(PieChart *chart) const
+{
+    chart->setTitle(m_title);
+    chart->setBreakdownValues("Rest", m_restSlices);
+    chart->setBreakdownValues("Work", m_workSlices);
+}
+
+//----------------------------------------------------------------------------
+void ChartsContents::apply(HistogramChart *chart) const
+{
+    chart->setTitle(m_title);
+    chart->setCategoriesTitle(m_categoriesTitle);
+    chart->setValues(m_categories, m_bars);
+}
+
+//----------------------------------------------------------------------------
+QString ChartsContents::chartTaskName(const QString& name)
+{
+    auto taskName = name;
+
+    // this is "mine" thing, I don't know why I use to end task names with a point
+    if(taskName.endsWith('.')) taskName.removeLast();
+
+    return taskName;
+}
+
+//----------------------------------------------------------------------------
+std::set<QString> ChartsContents::topTasks(const std::map<QString, unsigned long long> &times, const size_t count)
+{
+    std::vector<std::pair<unsigned long long, QString>> tasks;
+    tasks.reserve(times.size());
+    for(const auto &[name, duration]: times)
+    {
+        if(name == Utils::LONG_BREAK || name == Utils::SHORT_BREAK) continue;
+        tasks.emplace_back(duration, name);
+    }
+
+    // only the first positions need to be sorted.
+    const auto last = tasks.begin() + std::min(count, tasks.size());
+    std::partial_sort(tasks.begin(), last, tasks.end(), std::greater<>());
+
+    std::set<QString> result;
+    std::for_each(tasks.begin(), last, [&result](const auto &task) { result.insert(task.second); });
+
+    // grouping a single task doesn't save anything.
+    if(count < tasks.size() && tasks.size() == count + 1) result.insert(tasks.back().second);
+
+    return result;
+}
+
+//----------------------------------------------------------------------------
+QString ChartsContents::bucketLabel(const QDateTime& bucketStart, const Utils::Granularity granularity)
+{
+    switch(granularity)
+    {
+        case Utils::Granularity::MONTH:
+            return bucketStart.toString("MM/yyyy");
+        case Utils::Granularity::WEEK:
+        case Utils::Granularity::DAY:
+        default:
+            break;
+    }
+
+    return bucketStart.toString("dd/MM");
+}
+
+//----------------------------------------------------------------------------
+QString ChartsContents::bucketTitle(const Utils::Granularity granularity)
+{
+    switch(granularity)
+    {
+        case Utils::Granularity::MONTH:
+            return "Months";
+        case Utils::Granularity::WEEK:
+            return "Weeks";
+        case Utils::Granularity::DAY:
+        default:
+            break;
+    }
+
+    return "Days";
+}
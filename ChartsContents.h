@@ -0,0 +1,174 @@
+/*
+ File: ChartsContents.h
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _CHARTS_CONTENTS_H_
+#define _CHARTS_CONTENTS_H_
+
+// Project
+#include <Utils.h>
+#include <HistogramChart.h>
+#include <PieChart.h>
+
+// Qt
+#include <QString>
+#include <QStringList>
+
+// C++
+#include <map>
+#include <set>
+#include <vector>
+
+/** \class ChartsContents
+ * \brief Values of the pie and histogram charts for a range. Building the contents doesn't touch
+ *        any chart object, so it can be done in any thread, and then applied to the charts in the
+ *        GUI thread.
+ *
+ */
+class ChartsContents
+{
+  public:
+    /** \brief Returns the contents of the charts for the given range.
+     * \param[in] from Start date.
+     * \param[in] to End date.
+     * \param[in] granularity Size of the histogram buckets, must not be AUTO.
+     * \param[in] units Histogram of the range.
+     * \param[in] totals Milliseconds of each task in the range.
+     * \param[in] shownTasks Maximum number of work tasks shown, the rest are grouped.
+     *
+     */
+    static ChartsContents build(const QDateTime &from, const QDateTime &to, const Utils::Granularity granularity,
+                                const Utils::TaskHistogram &units, const std::map<QString, unsigned long long> &totals,
+                                const size_t shownTasks);
+
+    /** \brief Returns the milliseconds of each task in the given histogram.
+     * \param[in] units Task histogram.
+     *
+     */
+    static std::map<QString, unsigned long long> totals(const Utils::TaskHistogram &units);
+
+    /** \brief Returns a pie chart with the series the contents are applied to.
+     *
+     */
+    static PieChart *createPieChart();
+
+    /** \brief Returns a histogram chart configured to show the contents.
+     *
+     */
+    static HistogramChart *createHistogramChart();
+
+    /** \brief Returns true if the given slice is the one of the grouped tasks.
+     * \param[in] slice Slice of the pie chart.
+     *
+     */
+    static bool isOtherTasks(const QPieSlice *slice);
+
+    /** \brief Returns true if the given bar set is the one of the grouped tasks.
+     * \param[in] barset Bar set of the histogram chart.
+     *
+     */
+    static bool isOtherTasks(const QBarSet *barset);
+
+    /** \brief Adds time of a task to the contents. Returns true on success and false if the
+     * contents must be built again, like when the task is new, it enters the shown tasks or the
+     * time is out of the range of the contents.
+     * \param[in] name Task name in the database.
+     * \param[in] timeMs Start time of the unit in unix format.
+     * \param[in] durationMs Milliseconds to add.
+     *
+     */
+    bool add(const QString &name, const unsigned long long timeMs, const unsigned long long durationMs);
+
+    /** \brief Updates the pie chart with the contents.
+     * \param[in] chart Pie chart created with createPieChart().
+     *
+     */
+    void apply(PieChart *chart) const;
+
+    /** \brief Updates the histogram chart with the contents.
+     * \param[in] chart Histogram chart.
+     *
+     */
+    void apply(HistogramChart *chart) const;
+
+    /** \brief Returns true if there is no data in the range.
+     *
+     */
+    bool isEmpty() const
+    { return m_categories.isEmpty(); }
+
+    /** \brief Returns the start of each histogram bucket in unix format, in category order.
+     *
+     */
+    const std::vector<unsigned long long> &buckets() const
+    { return m_buckets; }
+
+    /** \brief Returns the number of slices of the pie chart.
+     *
+     */
+    qsizetype pieElements() const
+    { return m_restSlices.size() + m_workSlices.size(); }
+
+    /** \brief Returns the number of bars of the histogram chart.
+     *
+     */
+    qsizetype histogramElements() const
+    { return m_categories.size() * m_bars.size(); }
+
+  private:
+    /** \brief Returns the name of the task used in the charts.
+     * \param[in] name Task name in the database.
+     *
+     */
+    static QString chartTaskName(const QString &name);
+
+    /** \brief Returns the names of the tasks with more time, breaks excluded.
+     * \param[in] times Time of each task in milliseconds.
+     * \param[in] count Number of tasks to return.
+     *
+     */
+    static std::set<QString> topTasks(const std::map<QString, unsigned long long> &times, const size_t count);
+
+    /** \brief Returns the label of a histogram bucket.
+     * \param[in] bucketStart Start of the bucket.
+     * \param[in] granularity Size of the histogram buckets.
+     *
+     */
+    static QString bucketLabel(const QDateTime &bucketStart, const Utils::Granularity granularity);
+
+    /** \brief Returns the title of the histogram categories axis.
+     * \param[in] granularity Size of the histogram buckets.
+     *
+     */
+    static QString bucketTitle(const Utils::Granularity granularity);
+
+    QString m_range;                               /** range of days of the title. */
+    QString m_title;                               /** title of the charts. */
+    unsigned long long m_totalMs = 0;              /** milliseconds of all the tasks. */
+    std::map<QString, unsigned long long> m_times; /** milliseconds of each task, by chart name. */
+    std::set<QString> m_shown;                     /** work tasks not grouped. */
+    std::vector<PieChart::Slice> m_restSlices;     /** seconds of each break, keyed by chart name. */
+    std::vector<PieChart::Slice> m_workSlices;     /** seconds of each work task, keyed by chart name. */
+    QStringList m_categories;                      /** histogram category labels. */
+    QString m_categoriesTitle;                     /** histogram categories axis title. */
+    std::vector<unsigned long long> m_buckets;     /** start of each histogram bucket in unix format. */
+    unsigned long long m_end = 0;                  /** midnight after the last day of the range in unix format. */
+    std::vector<HistogramChart::Bars> m_bars;      /** histogram bars in stack order. */
+};
+
+#endif // _CHARTS_CONTENTS_H_
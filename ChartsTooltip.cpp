@@ -28,9 +28,10 @@
 
 // Project
 #include <ChartsTooltip.h>
+#include <Utils.h>
 
 //----------------------------------------------------------------------------
-ChartTooltip::ChartTooltip(const QString title, const qreal value)
+ChartTooltip::ChartTooltip()
 : QWidget(nullptr)
 {
   setWindowFlags(Qt::ToolTip|Qt::FramelessWindowHint|Qt::WindowStaysOnTopHint|Qt::WindowTransparentForInput);
@@ -40,6 +41,18 @@ ChartTooltip::ChartTooltip(const QString title, const qreal value)
   layout->setContentsMargins(QMargins{5,5,5,5});
   QFont font("Arial", 11);
   font.setBold(true);
+  m_title = new QLabel();
+  m_title->setAlignment(Qt::AlignCenter);
+  m_title->setFont(font);
+  layout->addWidget(m_title);
+  m_duration = new QLabel();
+  layout->addWidget(m_duration);
+  setLayout(layout);
+}
+
+//----------------------------------------------------------------------------
+void ChartTooltip::setContents(const QString title, const qreal value)
+{
   QString name = title;
   auto parts = name.split(' ');
   if(parts.size() > 1 && parts.last().contains('%'))
@@ -47,14 +60,9 @@ ChartTooltip::ChartTooltip(const QString title, const qreal value)
     parts.removeLast();
     name = parts.join(' ');
   }
-  auto titleLabel = new QLabel(name);
-  titleLabel->setAlignment(Qt::AlignCenter);
-  titleLabel->setFont(font);
-  layout->addWidget(titleLabel);
-  const auto timeText = QString("Duration ") + QTime{0,0,0}.addSecs(value).toString("hh:mm:ss");
-  auto sliceTime = new QLabel(timeText);
-  layout->addWidget(sliceTime);
-  setLayout(layout);
+  m_title->setText(name);
+  m_duration->setText(QString("Duration ") + Utils::durationToString(static_cast<unsigned long long>(value * 1000)));
+  adjustSize();
 }
 
 //----------------------------------------------------------------------------
@@ -23,6 +23,8 @@
 // Qt
 #include <QWidget>
 
+class QLabel;
+
 /** \class ChartTooltip
  * \brief Widget that acts as a tooltip for the charts.
  *
@@ -33,11 +35,16 @@ class ChartTooltip
     Q_OBJECT
   public:
     /** \brief ChartTooltip class constructor.
+     *
+     */
+    explicit ChartTooltip();
+
+    /** \brief Sets the contents of the tooltip. The tooltip is reused, only the texts are changed.
      * \param[in] title Tooltip title text.
      * \param[in] value Seconds of the entry.
      *
      */
-    explicit ChartTooltip(const QString title, const qreal value);
+    void setContents(const QString title, const qreal value);
 
     /** \brief ChartTooltip class virtual destructor.
      *
@@ -47,6 +54,10 @@ class ChartTooltip
 
   protected:
     virtual void paintEvent(QPaintEvent *event) override;
+
+  private:
+    QLabel *m_title;    /** title label. */
+    QLabel *m_duration; /** duration label. */
 };
 
 #endif
\ No newline at end of file
@@ -21,12 +21,15 @@
 #include <ConfigurationDialog.h>
 #include <Utils.h>
 #include <DesktopWidget.h>
+#include <Snapshot.h>
 
 // Qt
 #include <QColorDialog>
 #include <QApplication>
 #include <QScreen>
 #include <QMessageBox>
+#include <QFileDialog>
+#include <QDir>
 
 const QStringList DEFAULT_POSITIONS = {"Top Left",     "Top Center",  "Top Right",     "Center Left", "Center",
                                        "Center Right", "Bottom Left", "Bottom Center", "Bottom Right"};
@@ -53,9 +56,11 @@ ConfigurationDialog::ConfigurationDialog(const Utils::Configuration& config, QWi
     connectSignals();
     onWidgetCheckBoxChanged();
     onUseSoundCheckBoxChanged();
+    onPerformanceModeChanged();
 
     m_database = config.m_database;
     m_clearDatabase->setEnabled(m_database != nullptr && Utils::numberOfEntries(m_database, "TASKS") > 0);
+    m_importSnapshot->setEnabled(m_database != nullptr);
 }
 
 //----------------------------------------------------------------------------
@@ -87,6 +92,14 @@ void ConfigurationDialog::onUseSoundCheckBoxChanged()
     voiceCheckBox->setEnabled(enabled);
 }
 
+//----------------------------------------------------------------------------
+void ConfigurationDialog::onPerformanceModeChanged()
+{
+    const auto enabled = !m_performanceMode->isChecked();
+    m_animationLimit->setEnabled(enabled);
+    m_animationLimitLabel->setEnabled(enabled);
+}
+
 //----------------------------------------------------------------------------
 void ConfigurationDialog::onDatabaseClearPressed()
 {
@@ -100,10 +113,42 @@ void ConfigurationDialog::onDatabaseClearPressed()
     if(msgBox.exec() != QMessageBox::Yes) return;
 
     Utils::clearDatabase(m_database, "TASKS");
+    m_databaseCleared = true;
 
     m_clearDatabase->setEnabled(false);
 }
 
+//----------------------------------------------------------------------------
+void ConfigurationDialog::onImportSnapshotPressed()
+{
+    const auto fileName = QFileDialog::getOpenFileName(this, tr("Import snapshot"), QDir::homePath(), tr("WorkTimer snapshots (*.wts)"));
+    if(fileName.isEmpty()) return;
+
+    QMessageBox msgBox{this};
+    msgBox.setWindowIcon(QIcon(":/WorkTimer/configuration.svg"));
+    msgBox.setDefaultButton(QMessageBox::StandardButton::Ok);
+    msgBox.setStandardButtons(QMessageBox::StandardButton::Ok);
+
+    try
+    {
+        Snapshot snapshot{fileName};
+        snapshot.import(m_database);
+        m_databaseImported = true;
+
+        msgBox.setIcon(QMessageBox::Icon::Information);
+        msgBox.setText(QString("Imported %1 units.").arg(snapshot.size()));
+    }
+    catch(const std::runtime_error &e)
+    {
+        msgBox.setIcon(QMessageBox::Icon::Critical);
+        msgBox.setText(QString("Unable to import snapshot!\n%1").arg(e.what()));
+    }
+
+    m_clearDatabase->setEnabled(Utils::numberOfEntries(m_database, "TASKS") > 0);
+
+    msgBox.exec();
+}
+
 //----------------------------------------------------------------------------
 void ConfigurationDialog::showEvent(QShowEvent* e)
 {
@@ -129,6 +174,10 @@ void ConfigurationDialog::getConfiguration(Utils::Configuration& config)
     config.m_continuousTicTac = ticTacCheckBox->isChecked();
     config.m_iconMessages = m_iconMessagesCheckbox->isChecked();
     config.m_exportMs = m_exportMs->isChecked();
+    config.m_chartTasks = m_chartTasks->value();
+    config.m_compressionLevel = m_compressionLevel->value();
+    config.m_performanceMode = m_performanceMode->isChecked();
+    config.m_animationLimit = m_animationLimit->value();
     config.m_workUnitsBeforeBreak = unitsBeforeBreak->value();
 
     const auto posIdx = positionComboBox->currentIndex();
@@ -147,6 +196,8 @@ void ConfigurationDialog::connectSignals()
     connect(&m_widget, &DesktopWidget::beingDragged, this, [this](){ positionComboBox->setCurrentIndex(0); });
     connect(opacitySpinBox, &QSpinBox::valueChanged, this, [this](int v){ m_widget.setOpacity(v); });
     connect(m_clearDatabase, SIGNAL(pressed()), this, SLOT(onDatabaseClearPressed()));
+    connect(m_importSnapshot, SIGNAL(pressed()), this, SLOT(onImportSnapshotPressed()));
+    connect(m_performanceMode, SIGNAL(checkStateChanged(Qt::CheckState)), this, SLOT(onPerformanceModeChanged()));
 }
 
 //----------------------------------------------------------------------------
@@ -240,5 +291,9 @@ void ConfigurationDialog::setConfiguration(const Utils::Configuration &config)
 
     m_iconMessagesCheckbox->setChecked(config.m_iconMessages);
     m_exportMs->setChecked(config.m_exportMs);
+    m_chartTasks->setValue(config.m_chartTasks);
+    m_compressionLevel->setValue(config.m_compressionLevel);
+    m_performanceMode->setChecked(config.m_performanceMode);
+    m_animationLimit->setValue(config.m_animationLimit);
     voiceCheckBox->setChecked(config.m_useVoice);
 }
\ No newline at end of file
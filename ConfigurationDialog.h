@@ -58,6 +58,16 @@ class ConfigurationDialog : public QDialog, private Ui::ConfigurationDialog
      */
     void getConfiguration(Utils::Configuration& config);
 
+    /** \brief Returns true if the database has been cleared in the dialog and false otherwise.
+     */
+    bool databaseCleared() const
+    { return m_databaseCleared; }
+
+    /** \brief Returns true if a snapshot has been imported in the dialog and false otherwise.
+     */
+    bool databaseImported() const
+    { return m_databaseImported; }
+
   public slots:
     /** \brief Opens a color selection dialog to select a new color for the clicked unit button. 
      */
@@ -80,6 +90,14 @@ class ConfigurationDialog : public QDialog, private Ui::ConfigurationDialog
      */
     void onDatabaseClearPressed();
 
+    /** \brief Imports the units of a snapshot file selected by the user into the database.
+     */
+    void onImportSnapshotPressed();
+
+    /** \brief Modifies the UI when the user changes the value of the performance mode checkbox.
+     */
+    void onPerformanceModeChanged();
+
   protected:
     virtual void showEvent(QShowEvent* e) override;
 
@@ -106,6 +124,8 @@ class ConfigurationDialog : public QDialog, private Ui::ConfigurationDialog
     QList<QPoint> m_widgetPositions; /** possible fixed desktop widget positions. */
     DesktopWidget m_widget;          /** Desktop widget to show. */
     sqlite3* m_database;             /** SQLite database pointer. */
+    bool m_databaseCleared = false;  /** true if the database has been cleared, false otherwise. */
+    bool m_databaseImported = false; /** true if a snapshot has been imported, false otherwise. */
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,110 @@
+/*
+ File: CsvChunkWriter.cpp
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <CsvChunkWriter.h>
+#include <CsvFormatter.h>
+#include <BufferedWriter.h>
+
+// Qt
+#include <QThread>
+#include <QtConcurrent>
+
+// C++
+#include <algorithm>
+
+constexpr size_t CHUNK_ROWS = 8192;
+
+//-----------------------------------------------------------------
+CsvChunkWriter::CsvChunkWriter(BufferedWriter &file, const bool useMilliseconds)
+: m_file{file}
+, m_useMilliseconds{useMilliseconds}
+, m_maxPending{2 * static_cast<size_t>(std::max(1, QThread::idealThreadCount()))}
+{
+}
+
+//-----------------------------------------------------------------
+CsvChunkWriter::~CsvChunkWriter()
+{
+    for(auto &future: m_pending) future.waitForFinished();
+}
+
+//-----------------------------------------------------------------
+void CsvChunkWriter::append(const unsigned long long timeMs, const std::string_view name, const unsigned long long durationMs)
+{
+    m_chunk.times.push_back(timeMs);
+    m_chunk.durations.push_back(durationMs);
+    m_chunk.names.append(name);
+    m_chunk.nameEnds.push_back(m_chunk.names.size());
+
+    if(m_chunk.times.size() == CHUNK_ROWS) submit();
+}
+
+//-----------------------------------------------------------------
+void CsvChunkWriter::finish()
+{
+    if(!m_chunk.times.empty()) submit();
+
+    while(!m_pending.empty()) writeOldest();
+}
+
+//-----------------------------------------------------------------
+void CsvChunkWriter::submit()
+{
+    // the table isn't thread safe, so it's extended here and each chunk gets a copy. The rows
+    // are sorted, the years of the first and last rows include the rest.
+    if(!m_useMilliseconds)
+    {
+        m_days.day(m_chunk.times.front());
+        m_days.day(m_chunk.times.back());
+    }
+
+    auto future = QtConcurrent::run([chunk = std::move(m_chunk), days = m_days, useMs = m_useMilliseconds]()
+    {
+        CsvFormatter formatter{useMs, days};
+
+        size_t begin = 0;
+        for(size_t i = 0; i < chunk.times.size(); ++i)
+        {
+            const auto end = chunk.nameEnds[i];
+            formatter.append(chunk.times[i], std::string_view{chunk.names}.substr(begin, end - begin), chunk.durations[i]);
+            begin = end;
+        }
+
+        return formatter.release();
+    });
+
+    m_pending.push_back(future);
+    m_chunk = Chunk();
+    m_chunk.times.reserve(CHUNK_ROWS);
+    m_chunk.durations.reserve(CHUNK_ROWS);
+    m_chunk.nameEnds.reserve(CHUNK_ROWS);
+
+    // memory is bounded, the rows are read faster than they are formatted.
+    while(m_pending.size() > m_maxPending) writeOldest();
+}
+
+//-----------------------------------------------------------------
+void CsvChunkWriter::writeOldest()
+{
+    const auto text = m_pending.front().takeResult();
+    m_pending.pop_front();
+
+    m_file.write(text);
+}
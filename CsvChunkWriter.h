@@ -0,0 +1,107 @@
+/*
+ File: CsvChunkWriter.h
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _CSV_CHUNK_WRITER_H_
+#define _CSV_CHUNK_WRITER_H_
+
+// Project
+#include <DayTable.h>
+
+// Qt
+#include <QFuture>
+
+// C++
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class BufferedWriter;
+
+/** \class CsvChunkWriter
+ * \brief Formats the task rows of the CSV exports in parallel. Rows are grouped in chunks that are
+ *        formatted in the global thread pool, each one with its own formatter, and the formatted
+ *        chunks are written in order by the thread that adds the rows. The output is the same as
+ *        formatting the rows one by one.
+ *
+ */
+class CsvChunkWriter
+{
+  public:
+    /** \brief CsvChunkWriter class constructor.
+     * \param[in] file Output file.
+     * \param[in] useMilliseconds True to write the times and durations in milliseconds and false
+     *                            to write them as text.
+     *
+     */
+    CsvChunkWriter(BufferedWriter &file, const bool useMilliseconds);
+
+    /** \brief CsvChunkWriter class destructor. Waits for the chunks being formatted, the pending
+     * rows are discarded if finish() hasn't been called.
+     *
+     */
+    ~CsvChunkWriter();
+
+    CsvChunkWriter(const CsvChunkWriter &) = delete;
+    CsvChunkWriter &operator=(const CsvChunkWriter &) = delete;
+
+    /** \brief Adds a task row. Rows must be added in time order.
+     * \param[in] timeMs Start time of the unit in unix format.
+     * \param[in] name Task name.
+     * \param[in] durationMs Duration of the unit in milliseconds.
+     *
+     */
+    void append(const unsigned long long timeMs, const std::string_view name, const unsigned long long durationMs);
+
+    /** \brief Formats the pending rows and writes all the chunks to the file.
+     *
+     */
+    void finish();
+
+  private:
+    /** \struct Chunk
+     * \brief Rows of a chunk, the names are stored one after another in a single string.
+     */
+    struct Chunk
+    {
+        std::vector<unsigned long long> times;     /** start times of the units. */
+        std::vector<unsigned long long> durations; /** durations of the units. */
+        std::vector<size_t> nameEnds;              /** end position of the name of each unit. */
+        std::string names;                         /** names of the units. */
+    };
+
+    /** \brief Starts formatting the current chunk, writing the oldest chunks if there are too many pending.
+     *
+     */
+    void submit();
+
+    /** \brief Waits for the oldest formatted chunk and writes it to the file.
+     *
+     */
+    void writeOldest();
+
+    BufferedWriter &m_file;                      /** output file. */
+    const bool m_useMilliseconds;                /** true to write milliseconds, false to write text. */
+    const size_t m_maxPending;                   /** maximum number of chunks being formatted. */
+    DayTable m_days;                             /** local midnights of the days of the rows, copied to each chunk. */
+    Chunk m_chunk;                               /** rows of the current chunk. */
+    std::deque<QFuture<std::string>> m_pending;  /** chunks being formatted, in order. */
+};
+
+#endif // _CSV_CHUNK_WRITER_H_
@@ -0,0 +1,168 @@
+/*
+ File: CsvFormatter.cpp
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <CsvFormatter.h>
+
+// Qt
+#include <QDateTime>
+
+// C++
+#include <charconv>
+#include <string>
+
+constexpr unsigned long long MS_PER_SECOND = 1000;
+constexpr unsigned long long MS_PER_DAY = 24 * 60 * 60 * MS_PER_SECOND;
+
+/** \brief Appends the given number to the text.
+ * \param[inout] text Output text.
+ * \param[in] value Number to append.
+ * \param[in] digits Minimum number of digits, padded with zeros.
+ *
+ */
+static void appendNumber(std::string &text, const unsigned long long value, const int digits = 1)
+{
+    char number[24];
+    const auto end = std::to_chars(number, number + sizeof(number), value).ptr;
+    const auto length = static_cast<int>(end - number);
+
+    if(length < digits) text.append(digits - length, '0');
+    text.append(number, length);
+}
+
+/** \brief Appends the given number of seconds to the text, as "hh:mm:ss".
+ * \param[inout] text Output text.
+ * \param[in] seconds Number of seconds.
+ *
+ */
+static void appendTime(std::string &text, const unsigned long long seconds)
+{
+    appendNumber(text, seconds / 3600, 2);
+    text.push_back(':');
+    appendNumber(text, (seconds / 60) % 60, 2);
+    text.push_back(':');
+    appendNumber(text, seconds % 60, 2);
+}
+
+//-----------------------------------------------------------------
+CsvFormatter::CsvFormatter(const bool useMilliseconds, const DayTable &days)
+: m_useMilliseconds{useMilliseconds}
+, m_days{days}
+{
+    m_buffer.reserve(4096);
+}
+
+//-----------------------------------------------------------------
+void CsvFormatter::appendHeader()
+{
+    m_buffer.append("Date,Task name,Duration\r\n");
+}
+
+//-----------------------------------------------------------------
+void CsvFormatter::append(const unsigned long long timeMs, const std::string_view name, const unsigned long long durationMs)
+{
+    if(m_useMilliseconds)
+    {
+        appendNumber(m_buffer, timeMs);
+        m_buffer.push_back(',');
+        appendQuoted(name);
+        m_buffer.push_back(',');
+        appendNumber(m_buffer, durationMs);
+    }
+    else
+    {
+        appendDateTime(timeMs);
+        m_buffer.push_back(',');
+        appendQuoted(name);
+        m_buffer.push_back(',');
+        appendDuration(durationMs);
+    }
+    m_buffer.append("\r\n");
+}
+
+//-----------------------------------------------------------------
+std::string CsvFormatter::release()
+{
+    std::string text;
+    text.swap(m_buffer);
+
+    return text;
+}
+
+//-----------------------------------------------------------------
+void CsvFormatter::appendDateTime(const unsigned long long timeMs)
+{
+    // units are exported in time order, so the date only changes once per day.
+    const auto day = m_days.day(timeMs);
+    if(day != m_day)
+    {
+        const auto date = QDate::fromJulianDay(day);
+        m_day = day;
+        m_dayStart = m_days.start(day);
+        m_dayLength = m_days.start(day + 1) - m_dayStart;
+
+        m_date.clear();
+        appendNumber(m_date, date.day(), 2);
+        m_date.push_back('/');
+        appendNumber(m_date, date.month(), 2);
+        m_date.push_back('/');
+        appendNumber(m_date, date.year(), 4);
+        m_date.push_back(' ');
+    }
+    m_buffer.append(m_date);
+
+    // the time of the day can't be computed from the midnight when the clock changes.
+    unsigned long long seconds;
+    if(m_dayLength != MS_PER_DAY)
+        seconds = QDateTime::fromMSecsSinceEpoch(timeMs).time().msecsSinceStartOfDay() / MS_PER_SECOND;
+    else
+        seconds = (timeMs - m_dayStart) / MS_PER_SECOND;
+
+    appendTime(m_buffer, seconds);
+}
+
+//-----------------------------------------------------------------
+void CsvFormatter::appendDuration(const unsigned long long durationMs)
+{
+    // hours aren't wrapped, a duration isn't a time of the day.
+    appendTime(m_buffer, durationMs / MS_PER_SECOND);
+}
+
+//-----------------------------------------------------------------
+void CsvFormatter::appendQuoted(const std::string_view text)
+{
+    m_buffer.push_back('"');
+
+    size_t position = 0;
+    while(position < text.size())
+    {
+        const auto quote = text.find('"', position);
+        if(quote == std::string_view::npos)
+        {
+            m_buffer.append(text.data() + position, text.size() - position);
+            break;
+        }
+
+        m_buffer.append(text.data() + position, quote - position + 1);
+        m_buffer.push_back('"');
+        position = quote + 1;
+    }
+
+    m_buffer.push_back('"');
+}
@@ -0,0 +1,111 @@
+/*
+ File: CsvFormatter.h
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _CSV_FORMATTER_H_
+#define _CSV_FORMATTER_H_
+
+// Project
+#include <DayTable.h>
+
+// C++
+#include <string>
+#include <string_view>
+
+/** \class CsvFormatter
+ * \brief Formats the task rows of the CSV exports in a reusable buffer. Fields are escaped as
+ *        in RFC 4180, numbers are written with std::to_chars and the date of the rows is cached
+ *        per day, so formatting a row doesn't allocate or use the locale. Not thread safe.
+ *
+ */
+class CsvFormatter
+{
+  public:
+    /** \brief CsvFormatter class constructor.
+     * \param[in] useMilliseconds True to write the times and durations in milliseconds and false
+     *                            to write them as text.
+     * \param[in] days Table of the local midnights, it's extended when needed.
+     *
+     */
+    explicit CsvFormatter(const bool useMilliseconds, const DayTable &days = DayTable());
+
+    /** \brief CsvFormatter class destructor.
+     *
+     */
+    ~CsvFormatter()
+    {};
+
+    /** \brief Appends the header row to the buffer.
+     *
+     */
+    void appendHeader();
+
+    /** \brief Appends a task row to the buffer.
+     * \param[in] timeMs Start time of the unit in unix format.
+     * \param[in] name Task name.
+     * \param[in] durationMs Duration of the unit in milliseconds.
+     *
+     */
+    void append(const unsigned long long timeMs, const std::string_view name, const unsigned long long durationMs);
+
+    /** \brief Returns the formatted rows.
+     *
+     */
+    std::string_view text() const
+    { return m_buffer; }
+
+    /** \brief Empties the buffer, keeping its memory.
+     *
+     */
+    void clear()
+    { m_buffer.clear(); }
+
+    /** \brief Returns the formatted rows and empties the buffer.
+     *
+     */
+    std::string release();
+
+  private:
+    /** \brief Appends the local date and time of the given time to the buffer, as "dd/MM/yyyy hh:mm:ss".
+     * \param[in] timeMs Time in unix format.
+     *
+     */
+    void appendDateTime(const unsigned long long timeMs);
+
+    /** \brief Appends the given duration to the buffer, as "hh:mm:ss".
+     * \param[in] durationMs Duration in milliseconds.
+     *
+     */
+    void appendDuration(const unsigned long long durationMs);
+
+    /** \brief Appends the given text to the buffer as a quoted field, doubling the quotes in it.
+     * \param[in] text Field text.
+     *
+     */
+    void appendQuoted(const std::string_view text);
+
+    const bool m_useMilliseconds;       /** true to write milliseconds, false to write text. */
+    std::string m_buffer;               /** formatted rows. */
+    DayTable m_days;                    /** local midnights to compute the day of a time. */
+    qint64 m_day = 0;                   /** julian day of the cached date, 0 if none. */
+    unsigned long long m_dayStart = 0;  /** local midnight of the cached day in unix format. */
+    unsigned long long m_dayLength = 0; /** length of the cached day in milliseconds. */
+    std::string m_date;                 /** cached "dd/MM/yyyy " text of the day. */
+};
+
+#endif // _CSV_FORMATTER_H_
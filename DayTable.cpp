@@ -0,0 +1,112 @@
+/*
+ File: DayTable.cpp
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <DayTable.h>
+
+// Qt
+#include <QDateTime>
+
+// C++
+#include <algorithm>
+#include <mutex>
+
+constexpr unsigned long long MS_PER_DAY = 24 * 60 * 60 * 1000;
+
+//-----------------------------------------------------------------
+DayTable::DayTable(const QDate &first, const QDate &last)
+{
+    extend(first, last);
+}
+
+//-----------------------------------------------------------------
+qint64 DayTable::day(const unsigned long long timeMs)
+{
+    if (!contains(timeMs)) {
+        const auto date = QDateTime::fromMSecsSinceEpoch(timeMs).date();
+        extend(date, date);
+    }
+
+    // days last 24 hours except on daylight saving changes, so the estimation is at most one day off.
+    const auto last = static_cast<qint64>(m_starts.size()) - 2;
+    auto i = std::min(static_cast<qint64>((timeMs - m_starts.front()) / MS_PER_DAY), last);
+    while (i > 0 && m_starts[i] > timeMs) --i;
+    while (i < last && m_starts[i + 1] <= timeMs) ++i;
+
+    return m_firstDay + i;
+}
+
+//-----------------------------------------------------------------
+unsigned long long DayTable::start(const qint64 julianDay)
+{
+    if (m_starts.empty() || julianDay < m_firstDay || julianDay >= m_firstDay + static_cast<qint64>(m_starts.size())) {
+        const auto date = QDate::fromJulianDay(julianDay);
+        extend(date, date);
+    }
+
+    return m_starts[julianDay - m_firstDay];
+}
+
+//-----------------------------------------------------------------
+void DayTable::extend(const QDate &first, const QDate &last)
+{
+    // the shared table includes every table, resolving the local midnights is the expensive part.
+    static std::mutex mutex;
+    static DayTable shared;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    shared.compute(first, last);
+    m_firstDay = shared.m_firstDay;
+    m_starts = shared.m_starts;
+}
+
+//-----------------------------------------------------------------
+void DayTable::compute(const QDate &first, const QDate &last)
+{
+    const auto size = static_cast<qint64>(m_starts.size());
+
+    // whole years, the last position is the midnight after the last day.
+    auto firstDay = QDate{first.year(), 1, 1}.toJulianDay();
+    auto lastDay = QDate{last.year() + 1, 1, 1}.toJulianDay();
+    if (size != 0) {
+        firstDay = std::min(firstDay, m_firstDay);
+        lastDay = std::max(lastDay, m_firstDay + size - 1);
+
+        if (firstDay == m_firstDay && lastDay == m_firstDay + size - 1) return;
+    }
+
+    std::vector<unsigned long long> starts;
+    starts.reserve(lastDay - firstDay + 1);
+    for (auto day = firstDay; day <= lastDay; ++day) {
+        if (day >= m_firstDay && day < m_firstDay + size) {
+            starts.push_back(m_starts[day - m_firstDay]);
+        } else {
+            starts.push_back(QDateTime{QDate::fromJulianDay(day), QTime{0, 0, 0}}.toMSecsSinceEpoch());
+        }
+    }
+
+    m_firstDay = firstDay;
+    m_starts = std::move(starts);
+}
+
+//-----------------------------------------------------------------
+bool DayTable::contains(const unsigned long long timeMs) const
+{
+    return !m_starts.empty() && m_starts.front() <= timeMs && timeMs < m_starts.back();
+}
@@ -0,0 +1,99 @@
+/*
+ File: DayTable.h
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _DAY_TABLE_H_
+#define _DAY_TABLE_H_
+
+// Qt
+#include <QDate>
+
+// C++
+#include <vector>
+
+/** \class DayTable
+ * \brief Table of the local midnights of whole years in unix format. Days aren't a fixed
+ *        interval, they last 23 or 25 hours when daylight saving time changes, so the day
+ *        of a time is obtained from the table instead of dividing. The table grows when a
+ *        time outside of it is requested, copying the years from a table shared by the
+ *        whole application, so the midnights of each year are only computed once. Not
+ *        thread safe, use one table per thread.
+ *
+ */
+class DayTable
+{
+  public:
+    /** \brief DayTable class empty constructor.
+     *
+     */
+    DayTable()
+    {};
+
+    /** \brief DayTable class constructor.
+     * \param[in] first First date to include in the table.
+     * \param[in] last Last date to include in the table.
+     *
+     */
+    DayTable(const QDate &first, const QDate &last);
+
+    /** \brief DayTable class destructor.
+     *
+     */
+    ~DayTable()
+    {};
+
+    /** \brief Returns the julian day of the given time.
+     * \param[in] timeMs Time in unix format.
+     *
+     */
+    qint64 day(const unsigned long long timeMs);
+
+    /** \brief Returns the local midnight of the given day in unix format.
+     * \param[in] julianDay Julian day.
+     *
+     */
+    unsigned long long start(const qint64 julianDay);
+
+  private:
+    /** \brief Grows the table to include the whole years from the first to the last given dates,
+     * copying them from the shared table.
+     * \param[in] first First date to include.
+     * \param[in] last Last date to include.
+     *
+     */
+    void extend(const QDate &first, const QDate &last);
+
+    /** \brief Grows the table to include the whole years from the first to the last given dates,
+     * computing the midnights of the new days.
+     * \param[in] first First date to include.
+     * \param[in] last Last date to include.
+     *
+     */
+    void compute(const QDate &first, const QDate &last);
+
+    /** \brief Returns true if the given time is inside the table and false otherwise.
+     * \param[in] timeMs Time in unix format.
+     *
+     */
+    bool contains(const unsigned long long timeMs) const;
+
+    qint64 m_firstDay = 0;                  /** julian day of the first midnight of the table. */
+    std::vector<unsigned long long> m_starts; /** midnight of each day, the last one is the end of the table. */
+};
+
+#endif
@@ -0,0 +1,211 @@
+/*
+ File: HeatmapWidget.cpp
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <HeatmapWidget.h>
+#include <Utils.h>
+
+// Qt
+#include <QDate>
+#include <QPainter>
+#include <QHelpEvent>
+#include <QToolTip>
+
+// C++
+#include <algorithm>
+
+constexpr int YEAR_LABEL_WIDTH = 45; /** width of the year labels. */
+constexpr int WEEK_COLUMNS = 54;     /** maximum number of weeks that touch a year. */
+constexpr int YEAR_ROWS = 8;         /** rows of a year, the days of the week plus a separation. */
+constexpr int LEVELS = 4;            /** number of color levels of the days with work. */
+
+//----------------------------------------------------------------------------
+HeatmapWidget::HeatmapWidget(QWidget* parent, Qt::WindowFlags f) :
+    QWidget{parent, f}
+{
+}
+
+//----------------------------------------------------------------------------
+void HeatmapWidget::setValues(const std::map<qint64, unsigned long long>& days)
+{
+    if(days == m_days) return;
+
+    m_days = days;
+    m_maximum = 0;
+    for(const auto &[day, durationMs]: m_days) m_maximum = std::max(m_maximum, durationMs);
+
+    m_dirty = true;
+    update();
+}
+
+//----------------------------------------------------------------------------
+void HeatmapWidget::setValue(const qint64 day, const unsigned long long durationMs)
+{
+    auto it = m_days.find(day);
+    if(it != m_days.end() && it->second == durationMs) return;
+    if(it == m_days.end() && durationMs == 0) return;
+
+    m_days[day] = durationMs;
+    m_maximum = std::max(m_maximum, durationMs);
+
+    m_dirty = true;
+    update();
+}
+
+//----------------------------------------------------------------------------
+void HeatmapWidget::setColor(const QColor& color)
+{
+    if(color == m_color) return;
+
+    m_color = color;
+    m_dirty = true;
+    update();
+}
+
+//----------------------------------------------------------------------------
+void HeatmapWidget::resizeEvent(QResizeEvent* e)
+{
+    m_dirty = true;
+    QWidget::resizeEvent(e);
+}
+
+//----------------------------------------------------------------------------
+void HeatmapWidget::paintEvent(QPaintEvent*)
+{
+    // hidden widgets don't paint, the image is only regenerated when it's going to be shown.
+    if(m_dirty) renderImage();
+
+    QPainter painter(this);
+    painter.drawImage(0, 0, m_image);
+}
+
+//----------------------------------------------------------------------------
+bool HeatmapWidget::event(QEvent* e)
+{
+    if(e->type() == QEvent::ToolTip)
+    {
+        auto helpEvent = static_cast<QHelpEvent*>(e);
+        const auto day = dayAt(helpEvent->pos());
+        if(day != 0)
+        {
+            const auto it = m_days.find(day);
+            const auto durationMs = it != m_days.cend() ? it->second : 0;
+            QToolTip::showText(helpEvent->globalPos(), QString("%1 - %2").arg(QDate::fromJulianDay(day).toString("dd/MM/yyyy"))
+                                                                         .arg(Utils::durationToString(durationMs)), this);
+        }
+        else
+        {
+            QToolTip::hideText();
+            e->ignore();
+        }
+
+        return true;
+    }
+
+    return QWidget::event(e);
+}
+
+//----------------------------------------------------------------------------
+void HeatmapWidget::renderImage()
+{
+    m_dirty = false;
+
+    const auto ratio = devicePixelRatioF();
+    m_image = QImage(size() * ratio, QImage::Format_ARGB32_Premultiplied);
+    m_image.setDevicePixelRatio(ratio);
+    m_image.fill(Qt::transparent);
+
+    QPainter painter(&m_image);
+    painter.setRenderHint(QPainter::Antialiasing, false);
+
+    m_lastYear = QDate::currentDate().year();
+    m_firstYear = m_days.empty() ? m_lastYear : std::min(m_lastYear, QDate::fromJulianDay(m_days.begin()->first).year());
+
+    const auto years = m_lastYear - m_firstYear + 1;
+    m_cellSize = std::min((width() - YEAR_LABEL_WIDTH) / WEEK_COLUMNS, height() / (years * YEAR_ROWS));
+    if(m_cellSize < 3) return;
+
+    const auto spacing = std::max(1, m_cellSize / 6);
+    const auto cell = m_cellSize - spacing;
+
+    QFont font("Arial", std::max(6, std::min(12, m_cellSize)));
+    font.setBold(true);
+    painter.setFont(font);
+
+    painter.setPen(Qt::NoPen);
+    for(int year = m_lastYear; year >= m_firstYear; --year)
+    {
+        // most recent year on top.
+        const auto top = (m_lastYear - year) * YEAR_ROWS * m_cellSize;
+        painter.setPen(palette().color(QPalette::WindowText));
+        painter.drawText(QRect{0, top, YEAR_LABEL_WIDTH - spacing, 7 * m_cellSize}, Qt::AlignRight | Qt::AlignVCenter, QString::number(year));
+        painter.setPen(Qt::NoPen);
+
+        const auto first = QDate{year, 1, 1};
+        const auto firstMonday = first.toJulianDay() - (first.dayOfWeek() - 1);
+        const auto last = QDate{year, 12, 31}.toJulianDay();
+
+        auto it = m_days.lower_bound(first.toJulianDay());
+        for(auto day = first.toJulianDay(); day <= last; ++day)
+        {
+            unsigned long long durationMs = 0;
+            if(it != m_days.cend() && it->first == day)
+            {
+                durationMs = it->second;
+                ++it;
+            }
+
+            const auto column = (day - firstMonday) / 7;
+            const auto row = (day - firstMonday) % 7;
+            painter.setBrush(cellColor(durationMs));
+            painter.drawRect(YEAR_LABEL_WIDTH + column * m_cellSize, top + row * m_cellSize, cell, cell);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+qint64 HeatmapWidget::dayAt(const QPoint& position) const
+{
+    if(m_cellSize < 3 || position.x() < YEAR_LABEL_WIDTH || position.y() < 0) return 0;
+
+    const auto column = (position.x() - YEAR_LABEL_WIDTH) / m_cellSize;
+    const auto yearRow = position.y() / m_cellSize;
+    const auto year = m_lastYear - yearRow / YEAR_ROWS;
+    const auto row = yearRow % YEAR_ROWS;
+    if(row >= 7 || column >= WEEK_COLUMNS || year < m_firstYear) return 0;
+
+    const auto first = QDate{year, 1, 1};
+    const auto day = first.toJulianDay() - (first.dayOfWeek() - 1) + column * 7 + row;
+    if(day < first.toJulianDay() || day > QDate{year, 12, 31}.toJulianDay()) return 0;
+
+    return day;
+}
+
+//----------------------------------------------------------------------------
+QColor HeatmapWidget::cellColor(const unsigned long long durationMs) const
+{
+    const auto empty = palette().color(QPalette::Midlight);
+    if(durationMs == 0 || m_maximum == 0) return empty;
+
+    // discrete levels blended from the empty cell color to the given color, lighter() can't lighten dark colors.
+    const auto level = std::min<unsigned long long>(LEVELS - 1, (durationMs * LEVELS - 1) / m_maximum);
+    const auto weight = static_cast<double>(level + 1) / LEVELS;
+    auto blend = [weight](const int from, const int to) { return static_cast<int>(from + (to - from) * weight); };
+    return QColor{blend(empty.red(), m_color.red()), blend(empty.green(), m_color.green()), blend(empty.blue(), m_color.blue())};
+}
@@ -0,0 +1,104 @@
+/*
+ File: HeatmapWidget.h
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _HEATMAP_WIDGET_H_
+#define _HEATMAP_WIDGET_H_
+
+// Qt
+#include <QWidget>
+#include <QImage>
+#include <QColor>
+
+// C++
+#include <map>
+
+/** \class HeatmapWidget
+ * \brief Calendar heatmap with one cell per day colored by the work time of the day, one row of weeks
+ *        per year. The calendar is painted into a cached image that is only regenerated when the
+ *        values or the size of the widget change.
+ *
+ */
+class HeatmapWidget : public QWidget
+{
+    Q_OBJECT
+  public:
+    /** \brief HeatmapWidget class constructor.
+     * \param[in] parent Raw pointer of the widget parent of this one.
+     * \param[in] f Window flags.
+     *
+     */
+    explicit HeatmapWidget(QWidget* parent = nullptr, Qt::WindowFlags f = Qt::WindowFlags());
+
+    /** \brief HeatmapWidget class virtual destructor.
+     */
+    virtual ~HeatmapWidget() {};
+
+    /** \brief Replaces the values of all the days.
+     * \param[in] days Milliseconds of work of each julian day.
+     *
+     */
+    void setValues(const std::map<qint64, unsigned long long> &days);
+
+    /** \brief Sets the value of a day.
+     * \param[in] day Julian day.
+     * \param[in] durationMs Milliseconds of work of the day.
+     *
+     */
+    void setValue(const qint64 day, const unsigned long long durationMs);
+
+    /** \brief Sets the color of the days with the most work.
+     * \param[in] color Color.
+     *
+     */
+    void setColor(const QColor &color);
+
+  protected:
+    void paintEvent(QPaintEvent*) override;
+    void resizeEvent(QResizeEvent*) override;
+    bool event(QEvent* e) override;
+
+  private:
+    /** \brief Paints the calendar into the cached image.
+     *
+     */
+    void renderImage();
+
+    /** \brief Returns the julian day of the cell in the given position or 0 if there is none.
+     * \param[in] position Position in widget coordinates.
+     *
+     */
+    qint64 dayAt(const QPoint &position) const;
+
+    /** \brief Returns the color of a day with the given work time.
+     * \param[in] durationMs Milliseconds of work.
+     *
+     */
+    QColor cellColor(const unsigned long long durationMs) const;
+
+    std::map<qint64, unsigned long long> m_days; /** milliseconds of work of each julian day. */
+    unsigned long long m_maximum = 0;            /** highest value of a day. */
+    QColor m_color = QColor(79, 112, 88);        /** color of the days with the most work, the work unit color. */
+    QImage m_image;                              /** cached calendar image. */
+    bool m_dirty = true;                         /** true if the image needs to be regenerated. */
+    int m_firstYear = 0;                         /** first year of the calendar. */
+    int m_lastYear = 0;                          /** last year of the calendar. */
+    int m_cellSize = 0;                          /** size of a day cell in pixels, including the spacing. */
+};
+
+#endif // _HEATMAP_WIDGET_H_
@@ -0,0 +1,109 @@
+/*
+ File: HistogramCache.cpp
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <HistogramCache.h>
+
+// C++
+#include <algorithm>
+
+//-----------------------------------------------------------------
+HistogramCache::HistogramCache(const unsigned int capacity) :
+    m_capacity{std::max(1u, capacity)}
+{
+}
+
+//-----------------------------------------------------------------
+HistogramCache::Key HistogramCache::rangeKey(const QDateTime &from, const QDateTime &to, const Utils::Granularity granularity)
+{
+    auto beginning = from;
+    beginning.setTime(QTime{0, 0, 0});
+    auto ending = to;
+    ending.setTime(QTime{23, 59, 59});
+
+    // end of the key is the midnight after the last day, exclusive.
+    return Key{static_cast<unsigned long long>(beginning.toMSecsSinceEpoch()),
+               static_cast<unsigned long long>(ending.addSecs(1).toMSecsSinceEpoch()),
+               Utils::histogramGranularity(from, to, granularity)};
+}
+
+//-----------------------------------------------------------------
+const Utils::TaskHistogram &HistogramCache::histogram(const QDateTime &from, const QDateTime &to, Utils::Configuration &config,
+                                                      const Utils::Granularity granularity)
+{
+    const auto cached = find(from, to, granularity);
+    if (cached) return *cached;
+
+    const auto resolved = Utils::histogramGranularity(from, to, granularity);
+    return insert(from, to, resolved, Utils::taskHistogram(from, to, config, resolved));
+}
+
+//-----------------------------------------------------------------
+const Utils::TaskHistogram *HistogramCache::find(const QDateTime &from, const QDateTime &to, const Utils::Granularity granularity)
+{
+    auto it = m_index.find(rangeKey(from, to, granularity));
+    if (it == m_index.end()) return nullptr;
+
+    // move to the front, most recently used.
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return &m_entries.front().histogram;
+}
+
+//-----------------------------------------------------------------
+const Utils::TaskHistogram &HistogramCache::insert(const QDateTime &from, const QDateTime &to, const Utils::Granularity granularity,
+                                                   Utils::TaskHistogram histogram)
+{
+    const auto key = rangeKey(from, to, granularity);
+
+    auto it = m_index.find(key);
+    if (it != m_index.end()) {
+        m_entries.erase(it->second);
+        m_index.erase(it);
+    }
+
+    m_entries.push_front(Entry{key, std::move(histogram)});
+    m_index[key] = m_entries.begin();
+
+    while (m_entries.size() > m_capacity) {
+        m_index.erase(m_entries.back().key);
+        m_entries.pop_back();
+    }
+
+    return m_entries.front().histogram;
+}
+
+//-----------------------------------------------------------------
+void HistogramCache::invalidate(const unsigned long long timeMs)
+{
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (std::get<0>(it->key) <= timeMs && timeMs < std::get<1>(it->key)) {
+            m_index.erase(it->key);
+            it = m_entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+//-----------------------------------------------------------------
+void HistogramCache::clear()
+{
+    m_index.clear();
+    m_entries.clear();
+}
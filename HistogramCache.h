@@ -0,0 +1,118 @@
+/*
+ File: HistogramCache.h
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _HISTOGRAM_CACHE_H_
+#define _HISTOGRAM_CACHE_H_
+
+// Project
+#include <Utils.h>
+
+// C++
+#include <list>
+#include <map>
+#include <tuple>
+
+/** \class HistogramCache
+ * \brief Bounded LRU cache of the task histograms computed for a range of days.
+ *
+ */
+class HistogramCache
+{
+  public:
+    /** \brief HistogramCache class constructor.
+     * \param[in] capacity Maximum number of ranges kept in the cache.
+     *
+     */
+    explicit HistogramCache(const unsigned int capacity = 16);
+
+    /** \brief HistogramCache class destructor.
+     *
+     */
+    ~HistogramCache()
+    {};
+
+    /** \brief Returns the histogram of the given range, computing it only if it's not in the cache.
+     * \param[in] from Start date.
+     * \param[in] to End date.
+     * \param[in] config Application configuration that contains the database handle.
+     * \param[in] granularity Size of the buckets of the histogram.
+     *
+     */
+    const Utils::TaskHistogram &histogram(const QDateTime &from, const QDateTime &to, Utils::Configuration &config,
+                                          const Utils::Granularity granularity = Utils::Granularity::AUTO);
+
+    /** \brief Returns the cached histogram of the given range or nullptr if it's not in the cache.
+     * \param[in] from Start date.
+     * \param[in] to End date.
+     * \param[in] granularity Size of the buckets of the histogram.
+     *
+     */
+    const Utils::TaskHistogram *find(const QDateTime &from, const QDateTime &to,
+                                     const Utils::Granularity granularity = Utils::Granularity::AUTO);
+
+    /** \brief Inserts the histogram computed for the given range, replacing the previous one if any.
+     * \param[in] from Start date.
+     * \param[in] to End date.
+     * \param[in] granularity Size of the buckets of the histogram.
+     * \param[in] histogram Histogram of the range.
+     *
+     */
+    const Utils::TaskHistogram &insert(const QDateTime &from, const QDateTime &to, const Utils::Granularity granularity,
+                                       Utils::TaskHistogram histogram);
+
+    /** \brief Removes from the cache all the ranges that contain the given time.
+     * \param[in] timeMs Start time of the inserted or updated unit in unix format.
+     *
+     */
+    void invalidate(const unsigned long long timeMs);
+
+    /** \brief Removes all the entries of the cache.
+     *
+     */
+    void clear();
+
+  private:
+    using Key = std::tuple<unsigned long long, unsigned long long, Utils::Granularity>;
+
+    /** \brief Returns the normalized key of the given range, from the first to the last millisecond of the days
+     * and the granularity resolved for the range.
+     * \param[in] from Start date.
+     * \param[in] to End date.
+     * \param[in] granularity Requested size of the buckets of the histogram.
+     *
+     */
+    static Key rangeKey(const QDateTime &from, const QDateTime &to, const Utils::Granularity granularity);
+
+    /** \struct Entry
+     * \brief Cached range and its histogram.
+     */
+    struct Entry
+    {
+        Key key;                        /** normalized range. */
+        Utils::TaskHistogram histogram; /** histogram of the range. */
+    };
+
+    using EntryList = std::list<Entry>;
+
+    EntryList m_entries;                         /** cached entries, most recently used first. */
+    std::map<Key, EntryList::iterator> m_index;  /** key to entry position in the list. */
+    const unsigned int m_capacity;               /** maximum number of entries. */
+};
+
+#endif
@@ -0,0 +1,170 @@
+/*
+ File: HistogramChart.cpp
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <HistogramChart.h>
+
+// Qt
+#include <QBarSet>
+#include <QStackedBarSeries>
+#include <QBarCategoryAxis>
+#include <QValueAxis>
+
+// C++
+#include <algorithm>
+#include <set>
+
+constexpr const char *BARS_KEY = "barsKey";
+constexpr const char *BARS_GROUPED = "barsGrouped";
+
+//----------------------------------------------------------------------------
+HistogramChart::HistogramChart(QGraphicsItem* parent, Qt::WindowFlags wFlags) :
+    QChart(QChart::ChartTypeCartesian, parent, wFlags)
+{
+    m_series = new QStackedBarSeries();
+    addSeries(m_series);
+
+    m_axisX = new QBarCategoryAxis();
+    m_axisX->setLabelsAngle(-45);
+    m_axisX->setTruncateLabels(false);
+    addAxis(m_axisX, Qt::AlignBottom);
+    m_series->attachAxis(m_axisX);
+
+    m_axisY = new QValueAxis();
+    m_axisY->setLabelFormat("%0.2f");
+    m_axisY->setTitleText("Hours");
+    addAxis(m_axisY, Qt::AlignLeft);
+    m_series->attachAxis(m_axisY);
+}
+
+//----------------------------------------------------------------------------
+void HistogramChart::setValues(const QStringList &categories, const std::vector<Bars> &bars)
+{
+    auto barsets = m_series->barSets();
+
+    // bar sets are identified by key and group, the labels can be repeated.
+    auto id = [](const QBarSet *barset) { return std::make_pair(barset->property(BARS_KEY).toString(), isGrouped(barset)); };
+    std::set<std::pair<QString, bool>> ids;
+    for(const auto &b: bars) ids.emplace(b.key, b.grouped);
+
+    // bar sets keep the order of the given bars, remove the missing ones and merge the new ones in place.
+    for(auto it = barsets.begin(); it != barsets.end();) {
+        if(ids.find(id(*it)) == ids.cend()) {
+            m_series->remove(*it);
+            it = barsets.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // shrink the sets before changing the categories, the values are replaced later.
+    for(int i = 0; i < barsets.size(); ++i) {
+        if(barsets.at(i)->count() > categories.size())
+            barsets.at(i)->remove(categories.size(), barsets.at(i)->count() - categories.size());
+    }
+
+    if(m_axisX->categories() != categories)
+        m_axisX->setCategories(categories);
+
+    int i = 0;
+    for(const auto &b: bars) {
+        if(i < barsets.size() && id(barsets.at(i)) == std::make_pair(b.key, b.grouped)) {
+            if(barsets.at(i)->label() != b.label) barsets.at(i)->setLabel(b.label);
+            updateBarSet(barsets.at(i), b.values);
+        } else {
+            auto barset = createBarSet(b);
+            m_series->insert(i, barset);
+            barsets.insert(i, barset);
+        }
+        ++i;
+    }
+
+    // bar sets left after the given ones were out of order.
+    while(barsets.size() > i) {
+        m_series->remove(barsets.takeLast());
+    }
+
+    // the axis is fitted to the highest stack.
+    qreal maximum = 0;
+    for(int c = 0; c < categories.size(); ++c) {
+        qreal stack = 0;
+        for(const auto &b: bars) {
+            if(c < b.values.size()) stack += b.values.at(c);
+        }
+        maximum = std::max(maximum, stack);
+    }
+    m_axisY->setRange(0, maximum);
+    m_axisY->applyNiceNumbers();
+}
+
+//----------------------------------------------------------------------------
+void HistogramChart::setCategoriesTitle(const QString &title)
+{
+    if(m_axisX->titleText() != title)
+        m_axisX->setTitleText(title);
+}
+
+//----------------------------------------------------------------------------
+bool HistogramChart::isGrouped(const QBarSet *barset)
+{
+    return barset && barset->property(BARS_GROUPED).toBool();
+}
+
+//----------------------------------------------------------------------------
+QBarSet *HistogramChart::createBarSet(const Bars &bars)
+{
+    auto barset = new QBarSet(bars.label);
+    barset->setProperty(BARS_KEY, bars.key);
+    barset->setProperty(BARS_GROUPED, bars.grouped);
+    barset->setColor(bars.color);
+    barset->setBorderColor(bars.color.darker());
+    barset->append(bars.values);
+    connect(barset, &QBarSet::hovered, this, [this, barset](bool state, int index) { emit hovered(barset, state, index); });
+    connect(barset, &QBarSet::clicked, this, [this, barset](int index) { emit clicked(barset, index); });
+
+    return barset;
+}
+
+//----------------------------------------------------------------------------
+void HistogramChart::updateBarSet(QBarSet *barset, const QList<qreal> &values)
+{
+    if(barset->count() == values.size()) {
+        qsizetype changed = -1;
+        for(qsizetype i = 0; i < values.size(); ++i) {
+            if(barset->at(i) == values.at(i)) continue;
+
+            // more than one change, cheaper to replace all the values at once.
+            if(changed != -1) {
+                changed = -2;
+                break;
+            }
+            changed = i;
+        }
+
+        if(changed == -1) return;
+        if(changed >= 0) {
+            barset->replace(changed, values.at(changed));
+            return;
+        }
+    }
+
+    // every replace() or insert() emits signals, a single append() only one.
+    if(barset->count() > 0) barset->remove(0, barset->count());
+    barset->append(values);
+}
@@ -0,0 +1,107 @@
+/*
+ File: HistogramChart.h
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _HISTOGRAM_CHART_H_
+#define _HISTOGRAM_CHART_H_
+
+// Qt
+#include <QChart>
+#include <QColor>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+// C++
+#include <vector>
+
+class QBarSet;
+class QStackedBarSeries;
+class QBarCategoryAxis;
+class QValueAxis;
+
+/** \class HistogramChart
+ * \brief Implements the stacked histogram chart. The series and axes are kept between updates
+ *        and only the values that changed are modified.
+ */
+class HistogramChart : public QChart
+{
+    Q_OBJECT
+  public:
+    /** \struct Bars
+     * \brief Values of a task in each category of the histogram.
+     */
+    struct Bars
+    {
+        QString key;          /** identifies the bars, different bars can have the same label. */
+        QString label;        /** label of the task. */
+        QColor color;         /** color of the bars. */
+        QList<qreal> values;  /** value of each category. */
+        bool grouped = false; /** true if the bars are of a group of tasks instead of a single one. */
+    };
+
+    /** \brief HistogramChart class constructor.
+     * \param[in] parent Raw pointer of the parent of this object.
+     * \param[in] f Window flags.
+     */
+    HistogramChart(QGraphicsItem* parent = 0, Qt::WindowFlags f = Qt::WindowFlags());
+
+    /** \brief HistogramChart class virtual destructor.
+     */
+    virtual ~HistogramChart()
+    {};
+
+    /** \brief Updates the histogram with the given categories and bars, adding, removing or
+     * modifying only the bar sets and values that changed.
+     * \param[in] categories Category labels.
+     * \param[in] bars Bars of each task in stack order, with one value per category.
+     */
+    void setValues(const QStringList &categories, const std::vector<Bars> &bars);
+
+    /** \brief Sets the title of the categories axis.
+     * \param[in] title Axis title.
+     */
+    void setCategoriesTitle(const QString &title);
+
+    /** \brief Returns true if the given bar set is of a group of tasks.
+     * \param[in] barset Bar set of the histogram.
+     */
+    static bool isGrouped(const QBarSet *barset);
+
+  signals:
+    void hovered(QBarSet *barset, bool state, int index);
+    void clicked(QBarSet *barset, int index);
+
+  private:
+    /** \brief Helper method to create a bar set.
+     * \param[in] bars Bars of the task.
+     */
+    QBarSet *createBarSet(const Bars &bars);
+
+    /** \brief Helper method to update the values of a bar set.
+     * \param[in] barset Bar set to update.
+     * \param[in] values New values.
+     */
+    static void updateBarSet(QBarSet *barset, const QList<qreal> &values);
+
+    QStackedBarSeries* m_series; /** stacked bars series. */
+    QBarCategoryAxis* m_axisX;   /** categories axis. */
+    QValueAxis* m_axisY;         /** hours axis. */
+};
+
+#endif // _HISTOGRAM_CHART_H_
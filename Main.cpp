@@ -19,15 +19,25 @@
 
 // Project
 #include <MainWindow.h>
+#include <ChartRenderer.h>
+#include <Snapshot.h>
 
 // Qt
 #include <QApplication>
 #include <QSharedMemory>
 #include <QMessageBox>
 #include <QIcon>
+#include <QCommandLineParser>
+#include <QFileInfo>
 
 // C++
+#include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <windows.h>
 
 //-----------------------------------------------------------------
 void myMessageOutput(QtMsgType type, const QMessageLogContext& context, const QString& msg)
@@ -41,11 +51,237 @@ void myMessageOutput(QtMsgType type, const QMessageLogContext& context, const QS
     }
 }
 
+//-----------------------------------------------------------------
+void attachConsole()
+{
+    // the executable is linked as a GUI application without a console, the output of the
+    // command line modes is only visible in the console of the parent process, if any.
+    if(AttachConsole(ATTACH_PARENT_PROCESS))
+    {
+        std::freopen("CONOUT$", "w", stdout);
+        std::freopen("CONOUT$", "w", stderr);
+    }
+}
+
+//-----------------------------------------------------------------
+bool hasOption(int argc, char* argv[], const std::string &option)
+{
+    // only the option itself or with its value, not other options that start with the same name.
+    const auto withValue = option + "=";
+    return std::any_of(argv + 1, argv + argc, [&](const char *arg)
+    {
+        return std::strcmp(arg, option.c_str()) == 0 || std::strncmp(arg, withValue.c_str(), withValue.size()) == 0;
+    });
+}
+
+//-----------------------------------------------------------------
+void addRangeOptions(QCommandLineParser &parser, const QString &subject)
+{
+    parser.addOption({"from", QString("First day of the %1 in yyyy-MM-dd format, monday of this week by default.").arg(subject), "date"});
+    parser.addOption({"to", QString("Last day of the %1 in yyyy-MM-dd format, sunday of this week by default.").arg(subject), "date"});
+}
+
+//-----------------------------------------------------------------
+bool parseRange(const QCommandLineParser &parser, QDate &from, QDate &to)
+{
+    const auto today = QDate::currentDate();
+    from = parser.isSet("from") ? QDate::fromString(parser.value("from"), "yyyy-MM-dd") : today.addDays(1 - today.dayOfWeek());
+    to = parser.isSet("to") ? QDate::fromString(parser.value("to"), "yyyy-MM-dd") : from.addDays(6);
+    if(!from.isValid() || !to.isValid() || from > to)
+    {
+        std::cerr << "Invalid range of dates." << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------
+int renderCharts(QApplication &app)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Renders the charts of the work time to image files. Exits with 0 on success and 1 on error.");
+    parser.addHelpOption();
+    parser.addOption({"render", "Render the charts to files in <directory> and exit.", "directory"});
+    addRangeOptions(parser, "charts");
+    parser.addOption({"step", "Days of each chart: day, week, month or all.", "step", "week"});
+    parser.addOption({"format", "Image format: png or svg.", "format", "png"});
+    parser.addOption({"size", "Image size in pixels.", "WxH", "1024x768"});
+    parser.process(app);
+
+    QDate from, to;
+    if(!parseRange(parser, from, to)) return 1;
+
+    const std::map<QString, Utils::Granularity> steps{{"day", Utils::Granularity::DAY}, {"week", Utils::Granularity::WEEK},
+                                                      {"month", Utils::Granularity::MONTH}, {"all", Utils::Granularity::AUTO}};
+    const auto step = steps.find(parser.value("step"));
+    if(step == steps.cend())
+    {
+        std::cerr << "Invalid step, must be day, week, month or all." << std::endl;
+        return 1;
+    }
+
+    const auto format = parser.value("format").toLower();
+    if(format != "png" && format != "svg")
+    {
+        std::cerr << "Invalid format, must be png or svg." << std::endl;
+        return 1;
+    }
+
+    const auto dimensions = parser.value("size").split('x');
+    const QSize size{dimensions.first().toInt(), dimensions.last().toInt()};
+    if(dimensions.size() != 2 || size.isEmpty())
+    {
+        std::cerr << "Invalid size, must be WxH." << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        Utils::Configuration configuration;
+        configuration.load();
+
+        ChartRenderer renderer(configuration, size);
+        if(!renderer.render(ChartRenderer::ranges(from, to, step->second), parser.value("render"), format))
+        {
+            std::cerr << renderer.error().toStdString() << std::endl;
+            return 1;
+        }
+    }
+    catch(const std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+//-----------------------------------------------------------------
+int exportData(QCoreApplication &app)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Exports the work units to a file. Exits with 0 on success and 1 on error, scheduled\n"
+                                     "tasks without a console should rely on the exit code.");
+    parser.addHelpOption();
+    parser.addOption({"export", "Export the units to <file> and exit.", "file"});
+    addRangeOptions(parser, "units");
+    parser.addOption({"all", "Export all the units, ignoring the range of dates."});
+    parser.addOption({"format", "File format: csv, excel, report or snapshot. Deduced from the file extension by default.", "format"});
+    parser.addOption({"ms", "Export the times and durations in milliseconds."});
+    parser.addOption({"text", "Export the times and durations as text."});
+    parser.addOption({"level", "Compression level of the .gz CSV files, from 1 to 9. The configured one by default.", "level"});
+    parser.addOption({"append", "Append the units added since the last appending export to a CSV file, ignoring the range of dates."});
+    parser.process(app);
+
+    const auto filename = parser.value("export");
+    if(filename.isEmpty())
+    {
+        std::cerr << "Missing output file." << std::endl;
+        return 1;
+    }
+
+    QDate from, to;
+    if(!parser.isSet("all") && !parseRange(parser, from, to)) return 1;
+
+    const std::map<QString, QString> extensions{{"csv", "csv"}, {"gz", "csv"}, {"xlsx", "excel"}, {"wts", "snapshot"}};
+    auto format = parser.value("format").toLower();
+    if(format.isEmpty())
+    {
+        const auto extension = extensions.find(QFileInfo{filename}.suffix().toLower());
+        if(extension != extensions.cend()) format = extension->second;
+    }
+
+    if(format != "csv" && format != "excel" && format != "report" && format != "snapshot")
+    {
+        std::cerr << "Invalid format, must be csv, excel, report or snapshot." << std::endl;
+        return 1;
+    }
+
+    if(parser.isSet("append") && format != "csv")
+    {
+        std::cerr << "Only CSV files can be appended to." << std::endl;
+        return 1;
+    }
+
+    if(parser.isSet("ms") && parser.isSet("text"))
+    {
+        std::cerr << "Only one of --ms and --text can be used." << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        // only the settings and the database, none of the widgets, sounds or charts.
+        Utils::Configuration configuration;
+        configuration.load();
+
+        const auto useMs = parser.isSet("ms") || (configuration.m_exportMs && !parser.isSet("text"));
+        if(parser.isSet("level"))
+        {
+            const auto level = parser.value("level").toInt();
+            if(level < 1 || level > 9)
+            {
+                std::cerr << "Invalid compression level, must be in [1,9]." << std::endl;
+                return 1;
+            }
+
+            // only for this export, the configuration isn't saved.
+            configuration.m_compressionLevel = level;
+        }
+        const auto first = parser.isSet("all") ? QDateTime() : QDateTime{from, QTime{0, 0, 0}};
+        const auto last = parser.isSet("all") ? QDateTime() : QDateTime{to, QTime{0, 0, 0}};
+
+        bool exported = false;
+        if(parser.isSet("append"))
+            exported = Utils::appendDataCSV(filename, configuration, useMs);
+        else if(format == "csv")
+            exported = Utils::exportDataCSV(filename, configuration, first, last, useMs);
+        else if(format == "excel")
+            exported = Utils::exportDataExcel(filename, configuration, first, last, useMs);
+        else if(format == "report")
+            exported = Utils::exportReportExcel(filename, configuration, first, last);
+        else
+            exported = Snapshot::write(filename, configuration, first, last);
+
+        if(!exported)
+        {
+            std::cerr << "Unable to export the units to " << filename.toStdString() << std::endl;
+            return 1;
+        }
+    }
+    catch(const std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
 //-----------------------------------------------------------------
 int main(int argc, char* argv[])
 {
     qInstallMessageHandler(myMessageOutput);
 
+    // exporting only needs the settings and the database, not the GUI.
+    if(hasOption(argc, argv, "--export"))
+    {
+        attachConsole();
+        QCoreApplication app(argc, argv);
+        return exportData(app);
+    }
+
+    // rendering doesn't show any window, so it doesn't need a display or to be the only instance.
+    if(hasOption(argc, argv, "--render"))
+    {
+        if(qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) qputenv("QT_QPA_PLATFORM", "offscreen");
+        attachConsole();
+
+        QApplication app(argc, argv);
+        return renderCharts(app);
+    }
+
     QApplication app(argc, argv);
     app.setQuitOnLastWindowClosed(false);
 
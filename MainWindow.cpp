@@ -23,7 +23,11 @@
 #include <ConfigurationDialog.h>
 #include <ProgressWidget.h>
 #include <PieChart.h>
+#include <HistogramChart.h>
 #include <ChartsTooltip.h>
+#include <UnitsDialog.h>
+#include <TaskCursor.h>
+#include <Snapshot.h>
 #include <Quotes.h>
 
 // Qt
@@ -32,16 +36,22 @@
 #include <QEvent>
 #include <QMessageBox>
 #include <QCloseEvent>
+#include <QMouseEvent>
 #include <QMenu>
 #include <QVBoxLayout>
 #include <QLabel>
 #include <QDialogButtonBox>
 #include <QChartView>
 #include <QBarSet>
-#include <QStackedBarSeries>
-#include <QBarCategoryAxis>
-#include <QValueAxis>
 #include <QFileDialog>
+#include <QFileInfo>
+#include <QProgressDialog>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+
+// C++
+#include <algorithm>
+#include <limits>
 
 // SQLite
 extern "C"
@@ -50,10 +60,10 @@ extern "C"
 }
 
 const QString TIME_FORMAT = "hh:mm:ss";
-const QString SHORT_BREAK = "Short break";
-const QString LONG_BREAK = "Long break";
 const QString ERROR_STRING = "No data found. Do some work!\n\n\"It does not matter how slowly you\ngo so long as you do not stop.\" - Confucius";
 const int CustomRole = Qt::UserRole+1;
+constexpr int ANIMATION_DURATION_MS = 1000;      /** default QChart animation duration. */
+constexpr int SHORT_ANIMATION_DURATION_MS = 250; /** animation duration for charts close to the animation limit. */
 
 //----------------------------------------------------------------------------
 MainWindow::MainWindow(QWidget* p, Qt::WindowFlags f) :
@@ -68,10 +78,21 @@ MainWindow::MainWindow(QWidget* p, Qt::WindowFlags f) :
     m_taskBarButton.setState(QTaskBarButton::State::Invisible);
     m_taskBarButton.setValue(0);
 
+    // one query at a time, cancelled requests are discarded before they start.
+    m_chartsPool.setMaxThreadCount(1);
+
     connectSignals();
 
     m_configuration.load();
 
+    // a previous instance may have ended without clearing it.
+    m_configuration.setLiveUnitStart(0);
+
+    const auto entries = Utils::tasksList(m_configuration);
+    m_totalsIndex.build(entries);
+    m_statistics.build(entries);
+    m_heatmap->setValues(m_statistics.days());
+
     applyConfiguration();
 
     initIconAndMenu();
@@ -89,10 +110,24 @@ MainWindow::MainWindow(QWidget* p, Qt::WindowFlags f) :
 //----------------------------------------------------------------------------
 MainWindow::~MainWindow()
 {
+    m_chartsFuture.cancel();
+    m_chartsPool.waitForDone();
+
+    for(auto watcher: findChildren<QFutureWatcher<bool> *>()) watcher->cancel();
+    m_exportsPool.waitForDone();
+
+    // the watchers are destroyed before their finished signal is delivered, the partial files are removed here.
+    for(const auto &[watcher, fileName]: m_exportFiles)
+    {
+        const auto future = watcher->future();
+        if(future.resultCount() == 0 || !future.result()) QFile::remove(fileName);
+    }
+
     m_configuration.m_geometry = saveGeometry();
     m_configuration.m_state = saveState();
 
     m_configuration.save();
+    m_configuration.setLiveUnitStart(0);
     
     if(m_configuration.m_database)
         sqlite3_shutdown();
@@ -120,10 +155,18 @@ void MainWindow::connectSignals()
 
     connect(m_pieRange, SIGNAL(rangeChanged(const QDateTime&, const QDateTime&)), this, SLOT(onRangeChanged(const QDateTime&, const QDateTime&)));
     connect(m_pieRange, SIGNAL(exportDataCSV(const QDateTime&, const QDateTime&)), this, SLOT(exportDataCSV(const QDateTime&, const QDateTime&)));
+    connect(m_pieRange, SIGNAL(appendDataCSV()), this, SLOT(appendDataCSV()));
     connect(m_pieRange, SIGNAL(exportDataExcel(const QDateTime&, const QDateTime&)), this, SLOT(exportDataExcel(const QDateTime&, const QDateTime&)));
+    connect(m_pieRange, SIGNAL(exportReportExcel(const QDateTime&, const QDateTime&)), this, SLOT(exportReportExcel(const QDateTime&, const QDateTime&)));
+    connect(m_pieRange, SIGNAL(exportSnapshot(const QDateTime&, const QDateTime&)), this, SLOT(exportSnapshot(const QDateTime&, const QDateTime&)));
     connect(m_histogramRange, SIGNAL(rangeChanged(const QDateTime&, const QDateTime&)), this, SLOT(onRangeChanged(const QDateTime&, const QDateTime&)));
     connect(m_histogramRange, SIGNAL(exportDataCSV(const QDateTime&, const QDateTime&)), this, SLOT(exportDataCSV(const QDateTime&, const QDateTime&)));
+    connect(m_histogramRange, SIGNAL(appendDataCSV()), this, SLOT(appendDataCSV()));
     connect(m_histogramRange, SIGNAL(exportDataExcel(const QDateTime&, const QDateTime&)), this, SLOT(exportDataExcel(const QDateTime&, const QDateTime&)));
+    connect(m_histogramRange, SIGNAL(exportReportExcel(const QDateTime&, const QDateTime&)), this, SLOT(exportReportExcel(const QDateTime&, const QDateTime&)));
+    connect(m_histogramRange, SIGNAL(exportSnapshot(const QDateTime&, const QDateTime&)), this, SLOT(exportSnapshot(const QDateTime&, const QDateTime&)));
+
+    connect(tabWidget, SIGNAL(currentChanged(int)), this, SLOT(onTabChanged()));
 }
 
 //----------------------------------------------------------------------------
@@ -135,6 +178,7 @@ void MainWindow::applyConfiguration()
     m_widget.setVisible(false);
     m_widget.setPosition(m_configuration.m_widgetPosition);
     m_widget.setColor(m_configuration.m_workColor);
+    m_heatmap->setColor(m_configuration.m_workColor);
     m_widget.setIcon(":/WorkTimer/work.svg");
     m_widget.setProgress(0);
     m_widget.setOpacity(m_configuration.m_widgetOpacity);
@@ -173,6 +217,19 @@ void MainWindow::initTables()
     m_taskTable->horizontalHeader()->setSectionResizeMode(1, QHeaderView::ResizeToContents);
     m_taskTable->horizontalHeader()->setSectionResizeMode(2, QHeaderView::ResizeToContents);
     m_taskTable->verticalHeader()->setVisible(false);
+
+    m_weekdayTable->horizontalHeader()->setDefaultAlignment(Qt::AlignCenter);
+    m_weekdayTable->horizontalHeader()->setSectionsMovable(false);
+    m_weekdayTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    m_weekdayTable->verticalHeader()->setVisible(false);
+
+    m_taskStatisticsTable->horizontalHeader()->setDefaultAlignment(Qt::AlignCenter);
+    m_taskStatisticsTable->horizontalHeader()->setSectionsMovable(false);
+    m_taskStatisticsTable->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+    m_taskStatisticsTable->horizontalHeader()->setSectionResizeMode(1, QHeaderView::ResizeToContents);
+    m_taskStatisticsTable->horizontalHeader()->setSectionResizeMode(2, QHeaderView::ResizeToContents);
+    m_taskStatisticsTable->horizontalHeader()->setSectionResizeMode(3, QHeaderView::ResizeToContents);
+    m_taskStatisticsTable->verticalHeader()->setVisible(false);
 }
 
 //----------------------------------------------------------------------------
@@ -248,6 +305,31 @@ void MainWindow::initCharts()
     m_histogramError->setFont(font);
     m_histogramError->setAlignment(Qt::AlignCenter);
     m_histogramError->setVisible(false);
+
+    // bucket granularity only applies to the histogram.
+    m_pieRange->setGranularityVisible(false);
+
+    // a single tooltip for both charts, moved by the mouse events of the charts.
+    m_tooltip = std::make_shared<ChartTooltip>();
+    m_pieChart->viewport()->installEventFilter(this);
+    m_histogramChart->viewport()->installEventFilter(this);
+
+    // charts are created once, updates only modify their series.
+    m_donut = ChartsContents::createPieChart();
+    connect(m_donut, SIGNAL(hovered(QPieSlice*, bool)), this, SLOT(onPieHovered(QPieSlice*, bool)));
+    connect(m_donut, SIGNAL(clicked(QPieSlice*)), this, SLOT(onPieClicked(QPieSlice*)));
+
+    auto chart = m_pieChart->chart();
+    m_pieChart->setChart(m_donut);
+    if(chart) delete chart;
+
+    m_histogram = ChartsContents::createHistogramChart();
+    connect(m_histogram, SIGNAL(hovered(QBarSet*, bool, int)), this, SLOT(onBarHovered(QBarSet*, bool, int)));
+    connect(m_histogram, SIGNAL(clicked(QBarSet*, int)), this, SLOT(onBarClicked(QBarSet*, int)));
+
+    chart = m_histogramChart->chart();
+    m_histogramChart->setChart(m_histogram);
+    if(chart) delete chart;
 }
 
 //----------------------------------------------------------------------------
@@ -266,7 +348,7 @@ void MainWindow::updateItemTime(const QTime& timeToAdd, const int row, QTableWid
         const auto taskMs = QTime{0,0,0}.msecsTo(itemTime);
         const auto taskName = table->item(row,0)->text().toStdString();
         
-        Utils::insertUnitIntoDatabase(m_configuration, dateTime.toMSecsSinceEpoch(), taskName, taskMs);
+        storeUnit(dateTime.toMSecsSinceEpoch(), taskName, taskMs, QTime{0,0,0}.msecsTo(timeToAdd));
     }
 }
 
@@ -301,17 +383,88 @@ void MainWindow::insertItem(const QString& name)
     item->setTextAlignment(Qt::AlignCenter);
     m_taskTable->setItem(rows, 3, item);
 
-    Utils::insertUnitIntoDatabase(m_configuration, QDateTime::currentDateTime().toMSecsSinceEpoch(), name.toStdString(), 0);
+    storeUnit(dateTime.toMSecsSinceEpoch(), name.toStdString(), 0, 0);
+
+    // only the last row of the table is updated, the previous units won't change anymore.
+    if(m_timer.status() != WorkTimer::Status::Stopped)
+        m_configuration.setLiveUnitStart(dateTime.toMSecsSinceEpoch());
+}
+
+//----------------------------------------------------------------------------
+void MainWindow::storeUnit(const unsigned long long startTime, const std::string& name, const unsigned long long durationMs,
+                           const unsigned long long addedMs)
+{
+    Utils::insertUnitIntoDatabase(m_configuration, startTime, name, durationMs);
+    ++m_dataVersion;
+    m_histogramCache.invalidate(startTime);
+    m_totalsIndex.add(QString::fromStdString(name), startTime, addedMs);
+    m_statistics.add(QString::fromStdString(name), startTime, durationMs, addedMs);
+
+    // the same day the statistics added the time to.
+    const auto day = m_statistics.day(startTime);
+    const auto it = m_statistics.days().find(day);
+    if(it != m_statistics.days().cend()) m_heatmap->setValue(day, it->second);
+
+    addChartsTime(QString::fromStdString(name), startTime, addedMs);
+
+    if(tabWidget->currentWidget() == m_statisticsTab)
+        updateStatistics();
 }
 
 //----------------------------------------------------------------------------
 void MainWindow::updateChartsContents(const QDateTime &from, const QDateTime &to)
 {
-    auto toSeconds = [](const QTime t){ return QTime{0,0,0}.secsTo(t); };
-    const auto units = Utils::taskHistogram(from, to, m_configuration);
+    const auto granularity = Utils::histogramGranularity(from, to, m_histogramRange->granularity());
+    const auto generation = ++m_chartsGeneration;
+    m_chartsFrom = from;
+    m_chartsTo = to;
+
+    // the previous request has been superseded by this one, it's discarded if it hasn't started yet.
+    m_chartsFuture.cancel();
+
+    const auto cached = m_histogramCache.find(from, to, granularity);
+    if(cached)
+    {
+        fillCharts(from, to, granularity, *cached);
+        return;
+    }
+
+    const auto dataVersion = m_dataVersion;
+    m_chartsPending = true;
+    m_chartsFuture = QtConcurrent::run(&m_chartsPool, [config = m_configuration, from, to, granularity](QPromise<Utils::TaskHistogram> &promise) mutable
+    {
+        if(promise.isCanceled()) return;
+        promise.addResult(Utils::taskHistogram(from, to, config, granularity));
+    });
+
+    auto watcher = new QFutureWatcher<Utils::TaskHistogram>(this);
+    connect(watcher, &QFutureWatcher<Utils::TaskHistogram>::finished, this, [this, watcher, generation, dataVersion, from, to, granularity]()
+    {
+        watcher->deleteLater();
+        if(watcher->isCanceled() || watcher->future().resultCount() == 0) return;
+
+        // the database changed while computing, the result is outdated.
+        if(dataVersion != m_dataVersion)
+        {
+            if(generation == m_chartsGeneration) updateChartsContents(from, to);
+            return;
+        }
+
+        const auto &units = m_histogramCache.insert(from, to, granularity, watcher->future().takeResult());
+        if(generation == m_chartsGeneration) fillCharts(from, to, granularity, units);
+    });
+    watcher->setFuture(m_chartsFuture);
+}
+
+//----------------------------------------------------------------------------
+void MainWindow::fillCharts(const QDateTime &from, const QDateTime &to, const Utils::Granularity granularity,
+                            const Utils::TaskHistogram &units)
+{
+    m_chartsPending = false;
 
     if(units.empty())
     {
+        m_chartsContents = ChartsContents();
         m_pieChart->hide();
         m_histogramChart->hide();
         m_pieError->show();
@@ -327,138 +480,104 @@ void MainWindow::updateChartsContents(const QDateTime &from, const QDateTime &to
         m_histogramError->hide();
     }
 
-    QApplication::setOverrideCursor(Qt::WaitCursor);
-
-    // Pie chart
-    std::map<QString, QTime> times;
-    int hours = 0, minutes = 0, secs = 0;
-    for (const auto &[t, values]: units) {
-        for (const auto& unit : values) {
+    // tasks out of the top are grouped unless the user has expanded them.
+    const auto shownTasks = m_expandOtherTasks ? std::numeric_limits<size_t>::max() : static_cast<size_t>(m_configuration.m_chartTasks);
+    m_chartsContents = ChartsContents::build(from, to, granularity, units, m_totalsIndex.totals(from, to), shownTasks);
+    m_chartsGranularity = granularity;
 
-            hours += unit.duration.hour();
-            minutes += unit.duration.minute();
-            secs += unit.duration.second();
+    applyChartsContents();
+}
 
-            const auto seconds = toSeconds(unit.duration);
-            auto name = unit.name;
-            
-            // this is "mine" thing, I don't know why I use to end task names with a point
-            if(name.endsWith('.')) name.removeLast();
+//----------------------------------------------------------------------------
+void MainWindow::applyChartsContents()
+{
+    // animation options must be set before changing the series.
+    setChartAnimations(m_donut, QChart::AllAnimations, m_chartsContents.pieElements());
+    m_chartsContents.apply(m_donut);
 
-            if(times.find(name) == times.cend())
-                times[name] = QTime{0,0,0};
-            
-            times[name] = times[name].addSecs(seconds);
-        }
-    }
+    setChartAnimations(m_histogram, QChart::SeriesAnimations, m_chartsContents.histogramElements());
+    m_chartsContents.apply(m_histogram);
+}
 
-    hours += minutes / 60;
-    minutes = minutes % 60;
-    minutes += secs / 60;
-    secs = secs % 60;
-    const auto totalTime = QString("%1:%2:%3").arg(hours).arg(12).arg(33);
+//----------------------------------------------------------------------------
+void MainWindow::addChartsTime(const QString &name, const unsigned long long timeMs, const unsigned long long addedMs)
+{
+    const auto day = QDateTime::fromMSecsSinceEpoch(timeMs).date();
+    if(addedMs == 0 || day < m_chartsFrom.date() || day > m_chartsTo.date()) return;
 
-    QPieSeries *restSeries = new QPieSeries();
-    restSeries->setName("Rest");
-    QPieSeries *workSeries = new QPieSeries();
-    workSeries->setName("Work");
+    // the contents are of the previous range until the request finishes, the database changed
+    // meanwhile so its result is discarded and queried again.
+    if(m_chartsPending) return;
 
-    for(const auto &[name, duration]: times)
+    // only the bar and the slice of the task change, unless the charts need to be built again.
+    if(!m_chartsContents.add(name, timeMs, addedMs))
     {
-        auto serie = workSeries;
-        if(name == LONG_BREAK || name == SHORT_BREAK)
-            serie = restSeries;
-        
-        serie->append(Utils::toCamelCase(name), toSeconds(duration));
+        updateChartsContents(m_chartsFrom, m_chartsTo);
+        return;
     }
 
-    QFont font("Arial", 14);
-    font.setBold(true);
-
-    const QString timeString = QString(" - Total time: %1").arg(totalTime);
-    const QString title = from.toString("dd/MM") + " to " + to.toString("dd/MM") + timeString;
-    PieChart* donutBreakdown = new PieChart();
-    connect(donutBreakdown, SIGNAL(hovered(QPieSlice*, bool)), this, SLOT(onPieHovered(QPieSlice*, bool)));
-    donutBreakdown->setAnimationOptions(QChart::AllAnimations);
-    donutBreakdown->setTitle(title);
-    donutBreakdown->setTitleFont(font);
-    donutBreakdown->setBackgroundVisible(false);
-    donutBreakdown->legend()->setAlignment(Qt::AlignRight);
-    donutBreakdown->addBreakdownSeries(restSeries, QColor(79, 87, 112));
-    donutBreakdown->addBreakdownSeries(workSeries, QColor(79, 112, 88));
-    
-    auto piechart = m_pieChart->chart();
-    m_pieChart->setChart(donutBreakdown);
-    if(piechart) delete piechart;
+    applyChartsContents();
+}
 
-    // Histogram chart
-    std::map<QString, QBarSet *> barsets;
-    for(const auto &entry: times)
+//----------------------------------------------------------------------------
+void MainWindow::setChartAnimations(QChart *chart, const QChart::AnimationOptions options, const qsizetype elements) const
+{
+    if(m_configuration.m_performanceMode || elements > m_configuration.m_animationLimit)
     {
-        const auto color = entry.first == LONG_BREAK ? QColor(79, 87, 112) : (entry.first == SHORT_BREAK ? QColor(79, 87, 112).lighter() : QColor(79, 112, 88));
-        barsets[entry.first] = new QBarSet(Utils::toCamelCase(entry.first));
-        barsets[entry.first]->setColor(color);
-        barsets[entry.first]->setBorderColor(color.darker());
-        connect(barsets[entry.first], SIGNAL(hovered(bool, int)), this, SLOT(onBarHovered(bool, int)));
+        if(chart->animationOptions() != QChart::NoAnimation) chart->setAnimationOptions(QChart::NoAnimation);
+        return;
     }
 
-    auto fill = [](std::pair<QString, QBarSet *> entry){
-        entry.second->insert(entry.second->count(), 0);
-    };
+    // animation frames cost more with more elements, get them over with sooner near the limit.
+    const auto duration = (elements > m_configuration.m_animationLimit / 2) ? SHORT_ANIMATION_DURATION_MS : ANIMATION_DURATION_MS;
+    if(chart->animationDuration() != duration) chart->setAnimationDuration(duration);
+    if(chart->animationOptions() != options) chart->setAnimationOptions(options);
+}
 
-    for (const auto &[t, values]: units) {
-        std::for_each(barsets.begin(), barsets.end(), fill);
-        const auto pos = barsets.begin()->second->count() - 1;
+//----------------------------------------------------------------------------
+void MainWindow::updateStatistics()
+{
+    m_streaksLabel->setText(QString("Current streak: %1 days - Longest streak: %2 days")
+                                .arg(m_statistics.currentStreak())
+                                .arg(m_statistics.longestStreak()));
 
-        for (const auto& unit : values) {
-            const auto value = toSeconds(unit.duration) + barsets[unit.name]->at(pos);
-            barsets[unit.name]->replace(pos, static_cast<qreal>(value) / 3600);
+    auto setItem = [](QTableWidget *table, const int row, const int column, const QString &text)
+    {
+        auto item = table->item(row, column);
+        if(!item)
+        {
+            item = new QTableWidgetItem();
+            item->setTextAlignment(Qt::AlignCenter);
+            table->setItem(row, column, item);
         }
-    }
+        item->setText(text);
+    };
 
-    // order matters
-    auto series = new QStackedBarSeries;
-    for(auto &[name, barset]: barsets)
+    m_weekdayTable->setRowCount(1);
+    for(int day = 1; day <= 7; ++day)
     {
-        if(name == SHORT_BREAK || name == LONG_BREAK) continue;
-        series->append(barset);
+        const auto hours = m_statistics.weekdayAverageHours(day);
+        setItem(m_weekdayTable, 0, day - 1, Utils::durationToString(static_cast<unsigned long long>(hours * 3600 * 1000)));
     }
-    series->append(barsets[SHORT_BREAK]);
-    series->append(barsets[LONG_BREAK]);
 
-    auto histChart = new QChart;
-    histChart->addSeries(series);
-    histChart->setTitle(title);
-    histChart->setTitleFont(font);
-    histChart->setBackgroundVisible(false);
-    histChart->setAnimationOptions(QChart::SeriesAnimations);
-    histChart->legend()->setVisible(true);
-    histChart->legend()->setAlignment(Qt::AlignRight);
-
-    QStringList dates;
-    for (auto dateIt = from; dateIt.toMSecsSinceEpoch() < to.toMSecsSinceEpoch(); dateIt = dateIt.addDays(1)) {
-        dates << dateIt.toString("dd/MM");
+    const auto &tasks = m_statistics.tasks();
+    m_taskStatisticsTable->setRowCount(tasks.size());
+    int row = 0;
+    for(const auto &[name, stats]: tasks)
+    {
+        setItem(m_taskStatisticsTable, row, 0, name);
+        setItem(m_taskStatisticsTable, row, 1, QString::number(stats.units));
+        setItem(m_taskStatisticsTable, row, 2, Utils::durationToString(stats.medianMs));
+        setItem(m_taskStatisticsTable, row, 3, Utils::durationToString(stats.p90Ms));
+        ++row;
     }
+}
 
-    auto axisX = new QBarCategoryAxis;
-    axisX->append(dates);
-    axisX->setTitleText("Days");
-    axisX->setLabelsAngle(-45);
-    axisX->setTruncateLabels(false);
-    histChart->addAxis(axisX, Qt::AlignBottom);
-    series->attachAxis(axisX);
-
-    auto axisY = new QValueAxis;
-    axisY->setLabelFormat("%0.2f");
-    axisY->setTitleText("Hours");
-    histChart->addAxis(axisY, Qt::AlignLeft);
-    series->attachAxis(axisY);
-
-    auto histchart = m_histogramChart->chart();
-    m_histogramChart->setChart(histChart);
-    if(histchart) delete histchart;
-
-    QApplication::restoreOverrideCursor();
+//----------------------------------------------------------------------------
+void MainWindow::onTabChanged()
+{
+    if(tabWidget->currentWidget() == m_statisticsTab)
+        updateStatistics();
 }
 
 //----------------------------------------------------------------------------
@@ -491,6 +610,7 @@ void MainWindow::onRangeChanged(const QDateTime& from, const QDateTime& to)
         m_pieRange->setRange(from, to, false);
         m_histogramRange->setButton(rangeWidget->button());
         m_histogramRange->setRange(from, to, false);
+        m_expandOtherTasks = false;
         updateChartsContents(from, to);
     }
 }
@@ -498,8 +618,8 @@ void MainWindow::onRangeChanged(const QDateTime& from, const QDateTime& to)
 //----------------------------------------------------------------------------
 void MainWindow::exportDataCSV(const QDateTime& from, const QDateTime& to)
 {
-    auto tasks = Utils::tasksList(m_configuration, from, to);
-    if(tasks.empty())
+    const auto rows = TaskCursor::count(m_configuration.m_database, from, to);
+    if(rows == 0)
     {
         QMessageBox msgBox{this};
         msgBox.setWindowIcon(QIcon(":/WorkTimer/csv.svg"));
@@ -511,39 +631,75 @@ void MainWindow::exportDataCSV(const QDateTime& from, const QDateTime& to)
         return;
     }
 
-    auto fileName = QFileDialog::getSaveFileName(this, tr("Create CSV text file"), QDir::homePath(), tr("Text files (*.txt)"));
+    auto fileName = QFileDialog::getSaveFileName(this, tr("Create CSV text file"), QDir::homePath(), tr("Text files (*.txt);;Compressed CSV files (*.csv.gz)"));
+    if(fileName.isEmpty())
+        return;
+
+    const auto useMs = m_configuration.m_exportMs;
+    startExport(fileName, ":/WorkTimer/csv.svg", rows, [fileName, from, to, useMs](Utils::Configuration &config, const Utils::ExportProgress &progress)
+    {
+        return Utils::exportDataCSV(fileName, config, from, to, useMs, progress);
+    });
+}
+
+//----------------------------------------------------------------------------
+void MainWindow::appendDataCSV()
+{
+    auto fileName = QFileDialog::getSaveFileName(this, tr("Append new units to CSV text file"), QDir::homePath(), tr("Text files (*.txt *.csv);;Compressed CSV files (*.csv.gz)"),
+                                                 nullptr, QFileDialog::DontConfirmOverwrite);
     if(fileName.isEmpty())
         return;
 
-    if(!Utils::exportDataCSV(fileName, tasks, m_configuration.m_exportMs))
+    const auto watermark = m_configuration.exportWatermark(fileName);
+    const auto rows = TaskCursor::count(m_configuration.m_database, watermark, m_configuration.liveUnitStart());
+    if(rows == 0)
     {
         QMessageBox msgBox{this};
         msgBox.setWindowIcon(QIcon(":/WorkTimer/csv.svg"));
-        msgBox.setIcon(QMessageBox::Icon::Critical);
-        msgBox.setText("Unable to open text file!");
+        msgBox.setIcon(QMessageBox::Icon::Information);
+        msgBox.setText("No new data to export!");
         msgBox.setDefaultButton(QMessageBox::StandardButton::Ok);
         msgBox.setStandardButtons(QMessageBox::StandardButton::Ok);
         msgBox.exec();
         return;
     }
 
-    const QString details = QString("Exported to: %1").arg(fileName);
-    const QString msg = "Data successfully exported";
-    QMessageBox msgBox{this};
-    msgBox.setWindowIcon(QIcon(":/WorkTimer/csv.svg"));
-    msgBox.setIcon(QMessageBox::Icon::Information);
-    msgBox.setText(msg);
-    msgBox.setDetailedText(details);
-    msgBox.setDefaultButton(QMessageBox::StandardButton::Yes);
-    msgBox.setStandardButtons(QMessageBox::StandardButton::Yes);
-    msgBox.exec();
+    if(watermark == 0 && QFileInfo::exists(fileName))
+    {
+        QMessageBox msgBox{this};
+        msgBox.setWindowIcon(QIcon(":/WorkTimer/csv.svg"));
+        msgBox.setIcon(QMessageBox::Icon::Question);
+        msgBox.setText(tr("'%1' wasn't created by an append export, new units can't be appended to it.\nDo you want to replace it with all the units?").arg(QFileInfo{fileName}.fileName()));
+        msgBox.setDefaultButton(QMessageBox::StandardButton::No);
+        msgBox.setStandardButtons(QMessageBox::StandardButton::Yes | QMessageBox::StandardButton::No);
+        if(msgBox.exec() != QMessageBox::StandardButton::Yes)
+            return;
+
+        if(!QFile::remove(fileName))
+        {
+            QMessageBox errorBox{this};
+            errorBox.setWindowIcon(QIcon(":/WorkTimer/csv.svg"));
+            errorBox.setIcon(QMessageBox::Icon::Critical);
+            errorBox.setText(tr("Unable to replace '%1'.").arg(QFileInfo{fileName}.fileName()));
+            errorBox.setDefaultButton(QMessageBox::StandardButton::Ok);
+            errorBox.setStandardButtons(QMessageBox::StandardButton::Ok);
+            errorBox.exec();
+            return;
+        }
+    }
+
+    const auto useMs = m_configuration.m_exportMs;
+    startExport(fileName, ":/WorkTimer/csv.svg", rows, [fileName, useMs](Utils::Configuration &config, const Utils::ExportProgress &progress)
+    {
+        return Utils::appendDataCSV(fileName, config, useMs, progress);
+    }, watermark != 0);
 }
 
 //----------------------------------------------------------------------------
 void MainWindow::exportDataExcel(const QDateTime& from, const QDateTime& to)
 {
-    auto tasks = Utils::tasksList(m_configuration, from, to);
-    if(tasks.empty())
+    const auto rows = TaskCursor::count(m_configuration.m_database, from, to);
+    if(rows == 0)
     {
         QMessageBox msgBox{this};
         msgBox.setWindowIcon(QIcon(":/WorkTimer/excel.svg"));
@@ -559,27 +715,140 @@ void MainWindow::exportDataExcel(const QDateTime& from, const QDateTime& to)
     if(fileName.isEmpty())
         return;
 
-    if(!Utils::exportDataExcel(fileName, tasks, m_configuration.m_exportMs))
+    const auto useMs = m_configuration.m_exportMs;
+    startExport(fileName, ":/WorkTimer/excel.svg", rows, [fileName, from, to, useMs](Utils::Configuration &config, const Utils::ExportProgress &progress)
+    {
+        return Utils::exportDataExcel(fileName, config, from, to, useMs, progress);
+    });
+}
+
+//----------------------------------------------------------------------------
+void MainWindow::exportReportExcel(const QDateTime& from, const QDateTime& to)
+{
+    const auto rows = TaskCursor::count(m_configuration.m_database, from, to);
+    if(rows == 0)
     {
         QMessageBox msgBox{this};
         msgBox.setWindowIcon(QIcon(":/WorkTimer/excel.svg"));
-        msgBox.setIcon(QMessageBox::Icon::Critical);
-        msgBox.setText("Unable to create Excel file!");
+        msgBox.setIcon(QMessageBox::Icon::Information);
+        msgBox.setText("No data to export!");
         msgBox.setDefaultButton(QMessageBox::StandardButton::Ok);
         msgBox.setStandardButtons(QMessageBox::StandardButton::Ok);
         msgBox.exec();
         return;
     }
 
-    const QString details = QString("Exported to: %1").arg(fileName);
-    const QString msg = "Data successfully exported";
+    auto fileName = QFileDialog::getSaveFileName(this, tr("Create Excel report"), QDir::homePath(), tr("Excel files (*.xlsx)"));
+    if(fileName.isEmpty())
+        return;
+
+    startExport(fileName, ":/WorkTimer/excel.svg", rows, [fileName, from, to](Utils::Configuration &config, const Utils::ExportProgress &progress)
+    {
+        return Utils::exportReportExcel(fileName, config, from, to, progress);
+    });
+}
+
+//----------------------------------------------------------------------------
+void MainWindow::exportSnapshot(const QDateTime& from, const QDateTime& to)
+{
+    const auto rows = TaskCursor::count(m_configuration.m_database, from, to);
+    if(rows == 0)
+    {
+        QMessageBox msgBox{this};
+        msgBox.setWindowIcon(QIcon(":/WorkTimer/sqlite.svg"));
+        msgBox.setIcon(QMessageBox::Icon::Information);
+        msgBox.setText("No data to export!");
+        msgBox.setDefaultButton(QMessageBox::StandardButton::Ok);
+        msgBox.setStandardButtons(QMessageBox::StandardButton::Ok);
+        msgBox.exec();
+        return;
+    }
+
+    auto fileName = QFileDialog::getSaveFileName(this, tr("Export snapshot"), QDir::homePath(), tr("WorkTimer snapshots (*.wts)"));
+    if(fileName.isEmpty())
+        return;
+
+    if(!fileName.endsWith(".wts", Qt::CaseInsensitive))
+        fileName += ".wts";
+
+    startExport(fileName, ":/WorkTimer/sqlite.svg", rows, [fileName, from, to](Utils::Configuration &config, const Utils::ExportProgress &progress)
+    {
+        return Snapshot::write(fileName, config, from, to, progress);
+    });
+}
+
+//----------------------------------------------------------------------------
+void MainWindow::startExport(const QString &fileName, const QString &icon, const unsigned long long rows, const ExportJob &job,
+                             const bool append)
+{
+    // the export runs in the background, the timer and the widgets keep working meanwhile.
+    auto future = QtConcurrent::run(&m_exportsPool, [job, config = m_configuration, rows](QPromise<bool> &promise) mutable
+    {
+        promise.setProgressRange(0, 100);
+        auto progress = [&promise, rows](unsigned long long written)
+        {
+            promise.setProgressValue(static_cast<int>(std::min<unsigned long long>(100, (written * 100) / rows)));
+            return !promise.isCanceled();
+        };
+
+        promise.addResult(job(config, progress));
+    });
+
+    auto dialog = new QProgressDialog(QString("Exporting to %1").arg(QFileInfo{fileName}.fileName()), "Cancel", 0, 100, this);
+    dialog->setWindowIcon(QIcon(icon));
+    dialog->setWindowModality(Qt::NonModal);
+    dialog->setAutoClose(false);
+    dialog->setAutoReset(false);
+    dialog->setMinimumDuration(500);
+
+    auto watcher = new QFutureWatcher<bool>(this);
+    if(!append) m_exportFiles[watcher] = fileName;
+    connect(watcher, &QFutureWatcher<bool>::progressValueChanged, dialog, &QProgressDialog::setValue);
+    connect(dialog, &QProgressDialog::canceled, watcher, &QFutureWatcher<bool>::cancel);
+    connect(watcher, &QFutureWatcher<bool>::finished, this, [this, watcher, dialog, fileName, icon, append]()
+    {
+        watcher->deleteLater();
+        dialog->deleteLater();
+        m_exportFiles.erase(watcher);
+
+        // an appending job restores the file itself, it had data before the export.
+        if(watcher->isCanceled())
+        {
+            if(!append) QFile::remove(fileName);
+            return;
+        }
+
+        const auto exported = watcher->future().resultCount() > 0 && watcher->future().result();
+        exportFinished(fileName, icon, exported);
+    });
+    watcher->setFuture(future);
+}
+
+//----------------------------------------------------------------------------
+void MainWindow::exportFinished(const QString &fileName, const QString &icon, const bool exported)
+{
+    const QString msg = exported ? "Data successfully exported" : "Unable to export data!";
+
+    // the window may be hidden in the tray when the export finishes, failures are always reported.
+    if(m_trayIcon->isVisible())
+    {
+        if(m_configuration.m_iconMessages)
+        {
+            const auto type = exported ? QSystemTrayIcon::Information : QSystemTrayIcon::Critical;
+            m_trayIcon->showMessage(msg, QString("Exported to: %1").arg(fileName), type);
+            return;
+        }
+
+        if(exported) return;
+    }
+
     QMessageBox msgBox{this};
-    msgBox.setWindowIcon(QIcon(":/WorkTimer/excel.svg"));
-    msgBox.setIcon(QMessageBox::Icon::Information);
+    msgBox.setWindowIcon(QIcon(icon));
+    msgBox.setIcon(exported ? QMessageBox::Icon::Information : QMessageBox::Icon::Critical);
     msgBox.setText(msg);
-    msgBox.setDetailedText(details);
-    msgBox.setDefaultButton(QMessageBox::StandardButton::Yes);
-    msgBox.setStandardButtons(QMessageBox::StandardButton::Yes);
+    msgBox.setDetailedText(QString("Exported to: %1").arg(fileName));
+    msgBox.setDefaultButton(QMessageBox::StandardButton::Ok);
+    msgBox.setStandardButtons(QMessageBox::StandardButton::Ok);
     msgBox.exec();
 }
 
@@ -588,51 +857,123 @@ void MainWindow::onPieHovered(QPieSlice *slice, bool state)
 {
     if(!state)
     {
-        if (m_tooltip) {
-            m_tooltip->hide();
-            m_tooltip = nullptr;
-        }
+        m_tooltip->hide();
+        return;
     }
 
-    if(state && slice)
+    if(slice)
     {
-        m_tooltip = std::make_shared<ChartTooltip>(slice->label(), slice->value());
+        m_tooltip->setContents(slice->label(), slice->value());
         m_tooltip->move(QCursor::pos() + QPoint(15,15));
         m_tooltip->show();
-        QTimer::singleShot(10, this, SLOT(repositionTooltip()));
     }
 }
 
 //----------------------------------------------------------------------------
-void MainWindow::repositionTooltip()
+void MainWindow::onBarHovered(QBarSet *barset, bool state, int index)
 {
-    if(m_tooltip)
+    if(!state)
     {
-        m_tooltip->move(QCursor::pos() + QPoint(15,15));
-        QTimer::singleShot(10, this, SLOT(repositionTooltip()));
+        m_tooltip->hide();
+        return;
+    }
+
+    if(barset)
+    {
+        m_tooltip->setContents(barset->label(), barset->at(index) * 3600);
+        m_tooltip->move(QCursor::pos() + QPoint(15, 15));
+        m_tooltip->show();
     }
 }
 
 //----------------------------------------------------------------------------
-void MainWindow::onBarHovered(bool state, int index)
+bool MainWindow::eventFilter(QObject *object, QEvent *event)
 {
-    auto barset = qobject_cast<QBarSet*>(sender());
-    if(barset)
+    // the tooltip follows the mouse only while it's over the charts.
+    if(m_tooltip->isVisible() && (object == m_pieChart->viewport() || object == m_histogramChart->viewport()))
     {
-        if (!state && m_tooltip) {
-            m_tooltip->hide();
-            m_tooltip = nullptr;
+        switch(event->type())
+        {
+            case QEvent::MouseMove:
+                m_tooltip->move(static_cast<QMouseEvent *>(event)->globalPosition().toPoint() + QPoint(15, 15));
+                break;
+            case QEvent::Leave:
+                m_tooltip->hide();
+                break;
+            default:
+                break;
         }
+    }
+
+    return QMainWindow::eventFilter(object, event);
+}
+
+//----------------------------------------------------------------------------
+void MainWindow::onPieClicked(QPieSlice *slice)
+{
+    if(slice && ChartsContents::isOtherTasks(slice))
+        expandOtherTasks();
+}
+
+//----------------------------------------------------------------------------
+void MainWindow::onBarClicked(QBarSet *barset, int index)
+{
+    if(!barset) return;
+
+    if(ChartsContents::isOtherTasks(barset))
+    {
+        expandOtherTasks();
+        return;
+    }
 
-        if (state && !m_tooltip) {
-            const auto value = barset->at(index);
-            const auto title = barset->label();
-            m_tooltip = std::make_shared<ChartTooltip>(title, value * 3600);
-            m_tooltip->move(QCursor::pos() + QPoint(15, 15));
-            m_tooltip->show();
-            QTimer::singleShot(10, this, SLOT(repositionTooltip()));
+    showBucketUnits(index);
+}
+
+//----------------------------------------------------------------------------
+void MainWindow::showBucketUnits(const int index)
+{
+    const auto &buckets = m_chartsContents.buckets();
+    if(index < 0 || index >= static_cast<int>(buckets.size())) return;
+
+    // the histogram only has the totals, the units of the bucket are queried when requested.
+    const auto from = std::max(QDateTime::fromMSecsSinceEpoch(buckets[index]).date(), m_chartsFrom.date());
+    const auto to = std::min(Utils::nextBucket(from, m_chartsGranularity).addDays(-1), m_chartsTo.date());
+    // same bounds as the bar, from the first midnight to the midnight after the last day.
+    Utils::TaskTableEntries entries;
+    try
+    {
+        TaskCursor tasks{m_configuration.m_database, QDateTime{from, QTime{0, 0, 0}}, QDateTime{to, QTime{0, 0, 0}}};
+        while(tasks.next())
+        {
+            entries.emplace_back(std::string(tasks.name()), tasks.timeMs(), tasks.durationMs());
         }
     }
+    catch(const std::runtime_error &e)
+    {
+        QMessageBox msgBox{this};
+        msgBox.setWindowIcon(QIcon(":/WorkTimer/barchart.svg"));
+        msgBox.setIcon(QMessageBox::Icon::Critical);
+        msgBox.setText(QString("Unable to read the units!\n%1").arg(e.what()));
+        msgBox.setDefaultButton(QMessageBox::StandardButton::Ok);
+        msgBox.setStandardButtons(QMessageBox::StandardButton::Ok);
+        msgBox.exec();
+        return;
+    }
+    if(entries.empty()) return;
+
+    m_tooltip->hide();
+
+    UnitsDialog dialog(from, to, entries, this);
+    dialog.exec();
+}
+
+//----------------------------------------------------------------------------
+void MainWindow::expandOtherTasks()
+{
+    m_tooltip->hide();
+
+    m_expandOtherTasks = true;
+    updateChartsContents(m_chartsFrom, m_chartsTo);
 }
 
 //----------------------------------------------------------------------------
@@ -677,13 +1018,30 @@ void MainWindow::showAbout()
 void MainWindow::openConfiguration()
 {
     ConfigurationDialog dialog(m_configuration, this);
-    if (dialog.exec() != QDialog::Accepted) {
+    const auto result = dialog.exec();
+
+    // an import can follow a clear, so the indexes are rebuilt from the database.
+    const auto dataChanged = dialog.databaseCleared() || dialog.databaseImported();
+    if (dataChanged) {
+        ++m_dataVersion;
+        m_histogramCache.clear();
+
+        const auto entries = Utils::tasksList(m_configuration);
+        m_totalsIndex.build(entries);
+        m_statistics.build(entries);
+        m_heatmap->setValues(m_statistics.days());
+    }
+
+    if (result != QDialog::Accepted) {
+        if (dataChanged) updateChartsContents(m_chartsFrom, m_chartsTo);
         return;
     }
 
     dialog.getConfiguration(m_configuration);
     applyConfiguration();
     m_progressBar->setValue(0);
+
+    updateChartsContents(m_chartsFrom, m_chartsTo);
 }
 
 //----------------------------------------------------------------------------
@@ -701,6 +1059,8 @@ void MainWindow::onPlayClicked()
 
     switch (m_timer.status()) {
         case WorkTimer::Status::Stopped:
+            // the work time is added to the last row again.
+            m_configuration.setLiveUnitStart(m_taskTable->item(m_taskTable->rowCount() - 1, 3)->data(CustomRole).toDateTime().toMSecsSinceEpoch());
             m_timer.start();
             m_progressBar->setValue(0);
             actionTimer->setIcon(QIcon(":/WorkTimer/pause.svg"));
@@ -753,12 +1113,10 @@ void MainWindow::onStopClicked()
                 updateItemTime(elapsedTime, m_taskTable->rowCount() - 1, m_taskTable);
                 break;
             case WorkTimer::Status::ShortBreak:
-                Utils::insertUnitIntoDatabase(m_configuration, QDateTime::currentDateTime().toMSecsSinceEpoch() - elapsedMs,
-                                            SHORT_BREAK.toStdString(), elapsedMs);
+                storeUnit(QDateTime::currentDateTime().toMSecsSinceEpoch() - elapsedMs, Utils::SHORT_BREAK.toStdString(), elapsedMs, elapsedMs);
                 break;
             case WorkTimer::Status::LongBreak:
-                Utils::insertUnitIntoDatabase(m_configuration, QDateTime::currentDateTime().toMSecsSinceEpoch() - elapsedMs,
-                                            LONG_BREAK.toStdString(), elapsedMs);
+                storeUnit(QDateTime::currentDateTime().toMSecsSinceEpoch() - elapsedMs, Utils::LONG_BREAK.toStdString(), elapsedMs, elapsedMs);
                 break;
             default:
             case WorkTimer::Status::Paused:
@@ -766,6 +1124,9 @@ void MainWindow::onStopClicked()
         }
     }
 
+    // the last row won't change until the timer is started again.
+    m_configuration.setLiveUnitStart(0);
+
     m_timer.stop();
     actionStop->setEnabled(false);
     actionTimer->setIcon(QIcon(":/WorkTimer/play.svg"));
@@ -872,12 +1233,12 @@ void MainWindow::onUnitEnded()
         case WorkTimer::Status::ShortBreak:
             seconds = m_configuration.m_shortBreakTime * 60;
             m_globalProgress += m_configuration.m_shortBreakTime;
-            Utils::insertUnitIntoDatabase(m_configuration, 1000 * (QDateTime::currentDateTime().toSecsSinceEpoch() - seconds), SHORT_BREAK.toStdString(), seconds * 1000);
+            storeUnit(1000 * (QDateTime::currentDateTime().toSecsSinceEpoch() - seconds), Utils::SHORT_BREAK.toStdString(), seconds * 1000, seconds * 1000);
             break;
         case WorkTimer::Status::LongBreak:
             seconds = m_configuration.m_longBreakTime * 60;
             m_globalProgress += m_configuration.m_longBreakTime;
-            Utils::insertUnitIntoDatabase(m_configuration, 1000 * (QDateTime::currentDateTime().toSecsSinceEpoch() - seconds), LONG_BREAK.toStdString(), seconds * 1000);
+            storeUnit(1000 * (QDateTime::currentDateTime().toSecsSinceEpoch() - seconds), Utils::LONG_BREAK.toStdString(), seconds * 1000, seconds * 1000);
             break;
         case WorkTimer::Status::Stopped:
         case WorkTimer::Status::Paused:
@@ -911,7 +1272,7 @@ void MainWindow::onUnitStarted()
             minutes = m_configuration.m_shortBreakTime;
             m_widget.setColor(m_configuration.m_shortBreakColor);
             m_widget.setIcon(":/WorkTimer/rest.svg");
-            taskName = SHORT_BREAK;
+            taskName = Utils::SHORT_BREAK;
             iconMessage = "Started a short break";
             taskChangeEnabled = false;
             break;
@@ -919,7 +1280,7 @@ void MainWindow::onUnitStarted()
             minutes = m_configuration.m_longBreakTime;
             m_widget.setColor(m_configuration.m_longBreakColor);
             m_widget.setIcon(":/WorkTimer/rest.svg");
-            taskName = LONG_BREAK;
+            taskName = Utils::LONG_BREAK;
             iconMessage = "Started a long break";
             taskChangeEnabled = false;
             break;
@@ -25,16 +25,30 @@
 #include <Utils.h>
 #include <WorkTimer.h>
 #include <DesktopWidget.h>
+#include <HistogramCache.h>
+#include <TaskTotalsIndex.h>
+#include <Statistics.h>
+#include <ChartsContents.h>
 #include <QTaskBarButton/QTaskBarButton.h>
 
 // Qt
 #include <QMainWindow>
 #include <QSystemTrayIcon>
 #include <QDialog>
+#include <QThreadPool>
+#include <QChart>
+#include <QFuture>
+#include <QFutureWatcher>
+
+// C++
+#include <map>
 
 class QChartView;
 class QPieSlice;
+class QBarSet;
 class ChartTooltip;
+class PieChart;
+class HistogramChart;
 
 /** \class FinishDialog
  * \brief Implements the dialog to show when finising the session. Needed
@@ -82,6 +96,7 @@ class MainWindow : public QMainWindow, private Ui::MainWindow
 
   protected:
     virtual void closeEvent(QCloseEvent *) override;
+    virtual bool eventFilter(QObject *object, QEvent *event) override;
 
   private:
     /** \brief Helper method to connect signals to slots. 
@@ -131,18 +146,104 @@ class MainWindow : public QMainWindow, private Ui::MainWindow
      */
     void insertItem(const QString &name);
 
-    /** \brief Fills the charts with the data of the given time interval. 
+    /** \brief Helper method to insert or update a unit in the database and update the cached data of its day.
+     * \param[in] startTime Unit start time in unix format.
+     * \param[in] name Unit task name.
+     * \param[in] durationMs Unit duration in milliseconds.
+     * \param[in] addedMs Milliseconds added to the unit, equal to the duration for new units.
+     *
+     */
+    void storeUnit(const unsigned long long startTime, const std::string &name, const unsigned long long durationMs,
+                   const unsigned long long addedMs);
+
+    /** \brief Fills the charts with the data of the given time interval. The histogram is computed in the
+     * background if it's not cached and only the result of the last request is shown.
      * \param[in] from Start date.
      * \param[in] to End date. 
      *
      */
     void updateChartsContents(const QDateTime &from, const QDateTime &to);
 
+    /** \brief Fills the charts with the given histogram of the time interval.
+     * \param[in] from Start date.
+     * \param[in] to End date.
+     * \param[in] granularity Size of the histogram buckets.
+     * \param[in] units Histogram of the interval.
+     *
+     */
+    void fillCharts(const QDateTime &from, const QDateTime &to, const Utils::Granularity granularity,
+                    const Utils::TaskHistogram &units);
+
+    /** \brief Updates the charts with the current contents.
+     *
+     */
+    void applyChartsContents();
+
+    /** \brief Adds the time of a unit to the charts if it's inside their range.
+     * \param[in] name Task name.
+     * \param[in] timeMs Start time of the unit in unix format.
+     * \param[in] addedMs Milliseconds added to the unit.
+     *
+     */
+    void addChartsTime(const QString &name, const unsigned long long timeMs, const unsigned long long addedMs);
+
+    /** \brief Fills the statistics tab with the current statistics values.
+     *
+     */
+    void updateStatistics();
+
+    /** \brief Export job, writes the file with the given configuration and progress function.
+     */
+    using ExportJob = std::function<bool(Utils::Configuration &, const Utils::ExportProgress &)>;
+
+    /** \brief Runs the given export in the background with a progress dialog that can cancel it.
+     * \param[in] fileName Filename of the exported file.
+     * \param[in] icon Icon of the dialogs.
+     * \param[in] rows Number of rows to export.
+     * \param[in] job Export job.
+     * \param[in] append True if the job appends to an existing file, that isn't removed if the export is cancelled.
+     *
+     */
+    void startExport(const QString &fileName, const QString &icon, const unsigned long long rows, const ExportJob &job,
+                     const bool append = false);
+
+    /** \brief Notifies the result of an export.
+     * \param[in] fileName Filename of the exported file.
+     * \param[in] icon Icon of the dialogs.
+     * \param[in] exported True if the file was exported and false on error.
+     *
+     */
+    void exportFinished(const QString &fileName, const QString &icon, const bool exported);
+
+    /** \brief Shows in the charts the tasks grouped as other tasks.
+     *
+     */
+    void expandOtherTasks();
+
+    /** \brief Shows the units of a histogram bucket in a dialog.
+     * \param[in] index Index of the bucket in the histogram.
+     *
+     */
+    void showBucketUnits(const int index);
+
+    /** \brief Enables the given animations in the chart unless the performance mode is enabled or the chart
+     * has more elements than the configured limit.
+     * \param[in] chart Chart to configure.
+     * \param[in] options Animations of the chart.
+     * \param[in] elements Number of slices or bars of the chart.
+     *
+     */
+    void setChartAnimations(QChart *chart, const QChart::AnimationOptions options, const qsizetype elements) const;
+
   private slots:
     /** \brief Shows the About dialog.
      */
     void showAbout();
 
+    /** \brief Updates the contents of the tab when it's selected.
+     */
+    void onTabChanged();
+
     /** \brief Opens the configuration dialog and applies it.
      */
     void openConfiguration();
@@ -197,27 +298,51 @@ class MainWindow : public QMainWindow, private Ui::MainWindow
      */
     void exportDataCSV(const QDateTime &from, const QDateTime &to);
 
+    /** \brief Appends the units added since the last export to a CSV file on disk.
+     */
+    void appendDataCSV();
+
     /** \brief Exports the given data range to a CSV file on disk.
      * \param[in] from From date. 
      * \param[in] to To date. 
      */
     void exportDataExcel(const QDateTime &from, const QDateTime &to);
 
+    /** \brief Exports a report of the given data range to an Excel file on disk.
+     * \param[in] from From date. 
+     * \param[in] to To date. 
+     */
+    void exportReportExcel(const QDateTime &from, const QDateTime &to);
+
+    /** \brief Exports the given data range to a binary snapshot file on disk.
+     * \param[in] from From date. 
+     * \param[in] to To date. 
+     */
+    void exportSnapshot(const QDateTime &from, const QDateTime &to);
+
     /** \brief When a pie slice is hovered with the mouse shows a tooltip with the duration and task name.
      * \param[in] slice Hovered slice.
      * \param[in] status True if the mouse is over the slice and false otherwise. 
      */
     void onPieHovered(QPieSlice *slice, bool status);
 
-    /** \brief Repositions the tooltip over the mouse position. Used for both charts. 
-     */
-    void repositionTooltip();
-
     /** \brief When a bar is hovered with the mouse shows a tooltip with the duration and task name.
+     * \param[in] barset Bar set of the hovered bar.
      * \param[in] status True if the mouse is over the slice and false otherwise. 
      * \param[in] index Index of the bar series hovered.
      */
-    void onBarHovered(bool status, int index);
+    void onBarHovered(QBarSet *barset, bool status, int index);
+
+    /** \brief Expands the grouped tasks if the clicked slice is the other tasks slice.
+     * \param[in] slice Clicked slice.
+     */
+    void onPieClicked(QPieSlice *slice);
+
+    /** \brief Expands the grouped tasks if the clicked bar is an other tasks bar.
+     * \param[in] barset Bar set of the clicked bar.
+     * \param[in] index Index of the bar in the bar set.
+     */
+    void onBarClicked(QBarSet *barset, int index);
 
   private:
     Utils::Configuration m_configuration;    /** application configuration. */
@@ -232,6 +357,23 @@ class MainWindow : public QMainWindow, private Ui::MainWindow
     bool m_needsExit = false;                /** true to exit application at close(), false otherwise. */
     QTaskBarButton m_taskBarButton;          /** taskbar progress widget. */
     std::shared_ptr<ChartTooltip> m_tooltip; /** charts tooltip widget. */
+    HistogramCache m_histogramCache;         /** cache of the histograms of the last ranges shown. */
+    TaskTotalsIndex m_totalsIndex;           /** per-task cumulative time over the days of the database. */
+    Statistics m_statistics;                 /** work statistics. */
+    PieChart* m_donut = nullptr;             /** tasks pie chart. */
+    HistogramChart* m_histogram = nullptr;   /** tasks histogram chart. */
+    QDateTime m_chartsFrom;                  /** start of the range shown in the charts. */
+    QDateTime m_chartsTo;                    /** end of the range shown in the charts. */
+    bool m_expandOtherTasks = false;         /** true to show all the tasks in the charts, false to group the smaller ones. */
+    Utils::Granularity m_chartsGranularity = Utils::Granularity::DAY; /** size of the buckets of the histogram. */
+    ChartsContents m_chartsContents;         /** values shown in the charts. */
+    QThreadPool m_chartsPool;                /** thread to compute the chart data. */
+    QFuture<Utils::TaskHistogram> m_chartsFuture; /** last chart data request. */
+    unsigned int m_chartsGeneration = 0;     /** number of the last chart data request. */
+    bool m_chartsPending = false;            /** true while the charts wait for a data request. */
+    unsigned int m_dataVersion = 0;          /** number of database modifications, to discard outdated results. */
+    QThreadPool m_exportsPool;               /** threads of the export jobs. */
+    std::map<QFutureWatcher<bool> *, QString> m_exportFiles; /** files of the running exports that are removed if cancelled. */
 };
 
 #endif
\ No newline at end of file
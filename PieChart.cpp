@@ -24,6 +24,12 @@
 #include <QPieSlice>
 #include <QPieLegendMarker>
 
+// C++
+#include <set>
+
+constexpr const char *SLICE_KEY = "sliceKey";
+constexpr const char *SLICE_GROUPED = "sliceGrouped";
+
 //----------------------------------------------------------------------------
 MainSlice::MainSlice(QPieSeries* breakdownSeries, QObject* parent) :
     QPieSlice(parent),
@@ -59,6 +65,7 @@ void PieChart::addBreakdownSeries(QPieSeries* breakdownSeries, QColor color)
     mainSlice->setValue(breakdownSeries->sum());
     m_mainSeries->append(mainSlice);
     connect(breakdownSeries, SIGNAL(hovered(QPieSlice *, bool)), this, SIGNAL(hovered(QPieSlice *, bool)));
+    connect(breakdownSeries, SIGNAL(clicked(QPieSlice *)), this, SIGNAL(clicked(QPieSlice *)));
     connect(mainSlice, SIGNAL(hovered(bool)), this, SLOT(hoveredSlice(bool)));
 
     // customize the slice
@@ -72,11 +79,8 @@ void PieChart::addBreakdownSeries(QPieSeries* breakdownSeries, QColor color)
     breakdownSeries->setPieSize(0.8);
     breakdownSeries->setHoleSize(0.7);
     breakdownSeries->setLabelsVisible();
-    for(auto slice: breakdownSeries->slices()) {
-        color = color.lighter(115);
-        slice->setBrush(color);
-        slice->setLabelFont(font);
-    }
+    m_colors[breakdownSeries] = color;
+    colorSlices(breakdownSeries);
 
     // add the series to the chart
     QChart::addSeries(breakdownSeries);
@@ -88,6 +92,76 @@ void PieChart::addBreakdownSeries(QPieSeries* breakdownSeries, QColor color)
     updateLegendMarkers();
 }
 
+//----------------------------------------------------------------------------
+void PieChart::setBreakdownValues(const QString &name, const std::vector<Slice> &slices)
+{
+    MainSlice* mainSlice = nullptr;
+    for(auto slice: m_mainSeries->slices()) {
+        auto candidate = qobject_cast<MainSlice*>(slice);
+        if(candidate && candidate->name() == name) {
+            mainSlice = candidate;
+            break;
+        }
+    }
+    if(!mainSlice) return;
+
+    auto series = mainSlice->breakdownSeries();
+    auto current = series->slices();
+
+    // slices are identified by key and group, the labels can be repeated.
+    auto id = [](const QPieSlice *slice) { return std::make_pair(slice->property(SLICE_KEY).toString(), isGrouped(slice)); };
+    std::set<std::pair<QString, bool>> ids;
+    for(const auto &s: slices) ids.emplace(s.key, s.grouped);
+
+    // slices keep the given order, remove the missing ones and merge the new ones in place.
+    for(auto it = current.begin(); it != current.end();) {
+        if(ids.find(id(*it)) == ids.cend()) {
+            series->remove(*it);
+            it = current.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    bool inserted = false;
+    int i = 0;
+    for(const auto &s: slices) {
+        if(i < current.size() && id(current.at(i)) == std::make_pair(s.key, s.grouped)) {
+            if(current.at(i)->label() != s.label) current.at(i)->setLabel(s.label);
+            if(current.at(i)->value() != s.value) current.at(i)->setValue(s.value);
+        } else {
+            // the series labels visibility only applies to the slices it already has.
+            auto slice = new QPieSlice(s.label, s.value);
+            slice->setProperty(SLICE_KEY, s.key);
+            slice->setProperty(SLICE_GROUPED, s.grouped);
+            slice->setLabelVisible();
+            series->insert(i, slice);
+            current.insert(i, slice);
+            inserted = true;
+        }
+        ++i;
+    }
+
+    // slices left after the given ones were out of order.
+    while(current.size() > i) {
+        series->remove(current.takeLast());
+    }
+
+    if(inserted) colorSlices(series);
+
+    if(mainSlice->value() != series->sum()) mainSlice->setValue(series->sum());
+    mainSlice->setLabelVisible(series->sum() > 0);
+
+    recalculateAngles();
+    updateLegendMarkers();
+}
+
+//----------------------------------------------------------------------------
+bool PieChart::isGrouped(const QPieSlice *slice)
+{
+    return slice && slice->property(SLICE_GROUPED).toBool();
+}
+
 //----------------------------------------------------------------------------
 void PieChart::hoveredSlice(bool state)
 {
@@ -127,3 +201,16 @@ void PieChart::updateLegendMarkers()
         }
     }
 }
+
+//----------------------------------------------------------------------------
+void PieChart::colorSlices(QPieSeries* series)
+{
+    QFont font("Arial", 8);
+
+    auto color = m_colors[series];
+    for(auto slice: series->slices()) {
+        color = color.lighter(115);
+        slice->setBrush(color);
+        slice->setLabelFont(font);
+    }
+}
@@ -31,6 +31,10 @@
 #include <QPainter>
 #include <QAbstractSeries>
 
+// C++
+#include <map>
+#include <vector>
+
 /** \class MainSlice
  * \brief Implements the main slice style. 
  */
@@ -72,6 +76,17 @@ class PieChart : public QChart
 {
     Q_OBJECT
   public:
+    /** \struct Slice
+     * \brief Value of a slice of a breakdown series.
+     */
+    struct Slice
+    {
+        QString key;          /** identifies the slice, different slices can have the same label. */
+        QString label;        /** label of the slice. */
+        qreal value;          /** value of the slice. */
+        bool grouped = false; /** true if the slice is a group of elements instead of a single one. */
+    };
+
     /** \brief PieChart class constructor. 
      * \param[in] parent Raw pointer of the parent of this object.
      * \param[in] f Window flags. 
@@ -89,8 +104,21 @@ class PieChart : public QChart
      */
     void addBreakdownSeries(QPieSeries* series, QColor color);
 
+    /** \brief Updates the slices of a breakdown series with the given values, adding, removing or
+     * modifying only the slices that changed.
+     * \param[in] name Name of the breakdown series.
+     * \param[in] slices Slices of the series in order.
+     */
+    void setBreakdownValues(const QString &name, const std::vector<Slice> &slices);
+
+    /** \brief Returns true if the given slice of a breakdown series is a group of elements.
+     * \param[in] slice Slice of a breakdown series.
+     */
+    static bool isGrouped(const QPieSlice *slice);
+
   signals:
       void hovered(QPieSlice *slice, bool state);
+      void clicked(QPieSlice *slice);
 
   private slots:
     void hoveredSlice(bool state);      
@@ -104,8 +132,14 @@ class PieChart : public QChart
      */
     void updateLegendMarkers();
 
+    /** \brief Helper method to color the slices of a breakdown series.
+     * \param[in] series Breakdown series.
+     */
+    void colorSlices(QPieSeries* series);
+
   private:
-    QPieSeries* m_mainSeries; /** main series. */
+    QPieSeries* m_mainSeries;               /** main series. */
+    std::map<QPieSeries*, QColor> m_colors; /** base color of each breakdown series. */
 };
 
 #endif // PIECHART_H
\ No newline at end of file
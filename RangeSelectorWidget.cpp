@@ -26,7 +26,10 @@
 #include <QAction>
 
 const QString CSV_FILE = "CSV file";
+const QString CSV_APPEND = "New units to CSV file";
 const QString XLS_FILE = "Excel file";
+const QString XLS_REPORT = "Excel report";
+const QString SNAPSHOT = "Binary snapshot";
 
 //----------------------------------------------------------------------------
 RangeSelectorWidget::RangeSelectorWidget(QWidget* parent, Qt::WindowFlags f) :
@@ -41,13 +44,23 @@ RangeSelectorWidget::RangeSelectorWidget(QWidget* parent, Qt::WindowFlags f) :
 
     auto menu = new QMenu(m_export);
     auto csvAction = new QAction(QIcon(":/WorkTimer/csv.svg"), CSV_FILE, menu);
+    auto appendAction = new QAction(QIcon(":/WorkTimer/csv.svg"), CSV_APPEND, menu);
+    appendAction->setToolTip("Appends the units added since the last export to a CSV file, regardless of the range.");
     auto excelAction = new QAction(QIcon(":/WorkTimer/excel.svg"), XLS_FILE, menu);
+    auto reportAction = new QAction(QIcon(":/WorkTimer/excel.svg"), XLS_REPORT, menu);
+    auto snapshotAction = new QAction(QIcon(":/WorkTimer/sqlite.svg"), SNAPSHOT, menu);
     menu->addAction(csvAction);
+    menu->addAction(appendAction);
     menu->addAction(excelAction);
+    menu->addAction(reportAction);
+    menu->addAction(snapshotAction);
     m_export->setMenu(menu);
 
     connect(csvAction, SIGNAL(triggered(bool)), this, SLOT(onExportClicked()));
+    connect(appendAction, SIGNAL(triggered(bool)), this, SIGNAL(appendDataCSV()));
     connect(excelAction, SIGNAL(triggered(bool)), this, SLOT(onExportClicked()));
+    connect(reportAction, SIGNAL(triggered(bool)), this, SLOT(onExportClicked()));
+    connect(snapshotAction, SIGNAL(triggered(bool)), this, SLOT(onExportClicked()));
 }
 
 //----------------------------------------------------------------------------
@@ -159,11 +172,25 @@ void RangeSelectorWidget::onExportClicked()
         {
             emit exportDataCSV(m_fromDateEdit->dateTime(), m_toDateEdit->dateTime());
         }
+        else if(action->text().compare(XLS_REPORT) == 0)
+        {
+            emit exportReportExcel(m_fromDateEdit->dateTime(), m_toDateEdit->dateTime());
+        }
+        else if(action->text().compare(SNAPSHOT) == 0)
+        {
+            emit exportSnapshot(m_fromDateEdit->dateTime(), m_toDateEdit->dateTime());
+        }
         else
             emit exportDataExcel(m_fromDateEdit->dateTime(), m_toDateEdit->dateTime());
     }
 }
 
+//----------------------------------------------------------------------------
+void RangeSelectorWidget::onGranularityChanged()
+{
+    emit rangeChanged(m_fromDateEdit->dateTime(), m_toDateEdit->dateTime());
+}
+
 //----------------------------------------------------------------------------
 void RangeSelectorWidget::connectSignals()
 {
@@ -173,6 +200,7 @@ void RangeSelectorWidget::connectSignals()
     connect(m_custom, SIGNAL(toggled(bool)), this, SLOT(onButtonClicked()));
     connect(m_fromDateEdit, SIGNAL(dateChanged(QDate)), this, SLOT(onDateChanged()));
     connect(m_toDateEdit, SIGNAL(dateChanged(QDate)), this, SLOT(onDateChanged()));
+    connect(m_granularity, SIGNAL(currentIndexChanged(int)), this, SLOT(onGranularityChanged()));
 }
 
 //----------------------------------------------------------------------------
@@ -188,4 +216,24 @@ RangeSelectorWidget::Button RangeSelectorWidget::button() const
         return Button::YEAR;
 
     return Button::CUSTOM;
+}
+
+//----------------------------------------------------------------------------
+void RangeSelectorWidget::setGranularity(const Utils::Granularity granularity)
+{
+    m_granularity->blockSignals(true);
+    m_granularity->setCurrentIndex(static_cast<int>(granularity));
+    m_granularity->blockSignals(false);
+}
+
+//----------------------------------------------------------------------------
+Utils::Granularity RangeSelectorWidget::granularity() const
+{
+    return static_cast<Utils::Granularity>(m_granularity->currentIndex());
+}
+
+//----------------------------------------------------------------------------
+void RangeSelectorWidget::setGranularityVisible(const bool visible)
+{
+    m_granularity->setVisible(visible);
 }
\ No newline at end of file
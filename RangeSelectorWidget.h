@@ -20,6 +20,9 @@
 #ifndef _RANGE_SELECTOR_WIDGET_H_
 #define _RANGE_SELECTOR_WIDGET_H_
 
+// Project
+#include <Utils.h>
+
 // Qt
 #include <QWidget>
 #include "ui_RangeSelectorWidget.h"
@@ -64,10 +67,27 @@ class RangeSelectorWidget : public QWidget, private Ui::RangeSelectorWidget
      */
     Button button() const;
 
+    /** \brief Sets the selected histogram granularity without emitting a range signal.
+     * \param[in] granularity Granularity enum.
+     */
+    void setGranularity(const Utils::Granularity granularity);
+
+    /** \brief Returns the selected histogram granularity.
+     */
+    Utils::Granularity granularity() const;
+
+    /** \brief Shows or hides the histogram granularity selector.
+     * \param[in] visible True to show the selector and false to hide it.
+     */
+    void setGranularityVisible(const bool visible);
+
   signals:
     void rangeChanged(const QDateTime&, const QDateTime&);
     void exportDataCSV(const QDateTime&, const QDateTime&);
+    void appendDataCSV();
     void exportDataExcel(const QDateTime&, const QDateTime&);
+    void exportReportExcel(const QDateTime&, const QDateTime&);
+    void exportSnapshot(const QDateTime&, const QDateTime&);
 
   private slots:
     /** \brief Updates the range when a button gets clicked. 
@@ -78,10 +98,14 @@ class RangeSelectorWidget : public QWidget, private Ui::RangeSelectorWidget
      */
     void onDateChanged();
 
-    /** \brief Sends the signal to export data to a CSV file or an Excel file. 
+    /** \brief Sends the signal to export data to a CSV file, an Excel file or an Excel report. 
      */
     void onExportClicked();
 
+    /** \brief Emits the current range again when the histogram granularity changes.
+     */
+    void onGranularityChanged();
+
   private:
     /** \brief Helper method to connect signals to slots. 
      */
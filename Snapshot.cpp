@@ -0,0 +1,294 @@
+/*
+ File: Snapshot.cpp
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <Snapshot.h>
+#include <TaskCursor.h>
+
+// C++
+#include <charconv>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <string>
+
+// SQLite
+extern "C"
+{
+#include <sqlite3/sqlite3.h>
+}
+
+// zlib
+#include <zlib.h>
+
+const char HEADER_MAGIC[] = "WTSN";
+const char TRAILER_MAGIC[] = "WTSE";
+constexpr unsigned short VERSION = 1;
+constexpr size_t CHUNK_SIZE = 1 << 20;
+constexpr unsigned long long PROGRESS_UNITS = 1024;
+
+/** \brief Appends the given value to the buffer as a varint.
+ * \param[inout] buffer Output buffer.
+ * \param[in] value Value to append.
+ *
+ */
+static void appendVarint(std::string &buffer, unsigned long long value)
+{
+    while(value >= 0x80)
+    {
+        buffer.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<char>(value));
+}
+
+/** \brief Appends the given value to the buffer in little endian.
+ * \param[inout] buffer Output buffer.
+ * \param[in] value Value to append.
+ * \param[in] bytes Number of bytes of the value.
+ *
+ */
+static void appendFixed(std::string &buffer, unsigned long long value, const int bytes)
+{
+    for(int i = 0; i < bytes; ++i)
+    {
+        buffer.push_back(static_cast<char>(value & 0xFF));
+        value >>= 8;
+    }
+}
+
+/** \brief Returns the little endian value at the given position.
+ * \param[in] data Position of the value.
+ * \param[in] bytes Number of bytes of the value.
+ *
+ */
+static unsigned long long readFixed(const uchar *data, const int bytes)
+{
+    unsigned long long value = 0;
+    for(int i = bytes - 1; i >= 0; --i)
+    {
+        value = (value << 8) | data[i];
+    }
+
+    return value;
+}
+
+//-----------------------------------------------------------------
+Snapshot::Snapshot(const QString &filename)
+: m_file{filename}
+{
+    if(!m_file.open(QIODevice::ReadOnly))
+        throw std::runtime_error("Unable to open snapshot file!");
+
+    const auto size = m_file.size();
+    if(size < HEADER_SIZE + TRAILER_SIZE)
+        throw std::runtime_error("Invalid snapshot file!");
+
+    m_data = m_file.map(0, size);
+    if(!m_data)
+        throw std::runtime_error("Unable to map snapshot file!");
+
+    const auto trailer = m_data + size - TRAILER_SIZE;
+    if(std::memcmp(m_data, HEADER_MAGIC, 4) != 0 || std::memcmp(trailer + 20, TRAILER_MAGIC, 4) != 0)
+        throw std::runtime_error("Invalid snapshot file!");
+
+    if(readFixed(m_data + 4, 2) != VERSION)
+        throw std::runtime_error("Unsupported snapshot version!");
+
+    const auto checksum = crc32(crc32(0L, Z_NULL, 0), m_data, static_cast<uInt>(size - TRAILER_SIZE));
+    if(checksum != readFixed(trailer + 16, 4))
+        throw std::runtime_error("Corrupted snapshot!");
+
+    m_namesOffset = static_cast<qint64>(readFixed(trailer, 8));
+    m_units = readFixed(trailer + 8, 8);
+    if(m_namesOffset < HEADER_SIZE || m_namesOffset > size - TRAILER_SIZE)
+        throw std::runtime_error("Corrupted snapshot!");
+
+    auto data = m_data + m_namesOffset;
+    const auto end = trailer;
+    const auto count = readVarint(data, end);
+    if(count > static_cast<unsigned long long>(end - data))
+        throw std::runtime_error("Corrupted snapshot!");
+
+    m_names.reserve(count);
+    for(unsigned long long i = 0; i < count; ++i)
+    {
+        const auto length = readVarint(data, end);
+        if(length > static_cast<unsigned long long>(end - data))
+            throw std::runtime_error("Corrupted snapshot!");
+
+        m_names.emplace_back(reinterpret_cast<const char *>(data), length);
+        data += length;
+    }
+}
+
+//-----------------------------------------------------------------
+Snapshot::~Snapshot()
+{
+    if(m_data) m_file.unmap(const_cast<uchar *>(m_data));
+}
+
+//-----------------------------------------------------------------
+bool Snapshot::write(const QString &filename, Utils::Configuration &config, const QDateTime &from, const QDateTime &to,
+                     const Utils::ExportProgress &progress)
+{
+    // the file is overwritten, a later append must start from scratch.
+    config.setExportWatermark(filename, 0);
+
+    QFile file{filename};
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    // the units are encoded in a chunk that is written when full, the checksum is updated with each chunk.
+    std::string chunk;
+    chunk.reserve(CHUNK_SIZE + 64);
+    auto checksum = crc32(0L, Z_NULL, 0);
+    unsigned long long offset = 0;
+    bool error = false;
+    auto flush = [&]()
+    {
+        checksum = crc32(checksum, reinterpret_cast<const Bytef *>(chunk.data()), static_cast<uInt>(chunk.size()));
+        if(file.write(chunk.data(), chunk.size()) != static_cast<qint64>(chunk.size())) error = true;
+        offset += chunk.size();
+        chunk.clear();
+    };
+
+    chunk.append(HEADER_MAGIC, 4);
+    appendFixed(chunk, VERSION, 2);
+    appendFixed(chunk, 0, 2);
+
+    // a partial snapshot can't be read, the file is removed on any failure.
+    auto fail = [&file]()
+    {
+        file.close();
+        file.remove();
+        return false;
+    };
+
+    std::map<std::string, unsigned long long, std::less<>> ids;
+    std::vector<std::string_view> names;
+    unsigned long long units = 0;
+    try
+    {
+        TaskCursor tasks{config.m_database, from, to};
+
+        unsigned long long previous = 0;
+        while(tasks.next() && !error)
+        {
+            const auto time = tasks.timeMs();
+            const auto delta = static_cast<long long>(time - previous);
+            previous = time;
+
+            auto id = ids.find(tasks.name());
+            if(id == ids.end())
+            {
+                id = ids.emplace(std::string(tasks.name()), names.size()).first;
+                names.push_back(id->first);
+            }
+
+            appendVarint(chunk, (static_cast<unsigned long long>(delta) << 1) ^ static_cast<unsigned long long>(delta >> 63));
+            appendVarint(chunk, id->second);
+            appendVarint(chunk, tasks.durationMs());
+            if(chunk.size() >= CHUNK_SIZE) flush();
+
+            ++units;
+            if(progress && (units % PROGRESS_UNITS == 0) && !progress(units)) return fail();
+        }
+    }
+    catch(const std::runtime_error &e)
+    {
+        std::cerr << "Error exporting tasks [" << e.what() << "]\n";
+        return fail();
+    }
+    if(error) return fail();
+
+    const auto namesOffset = offset + chunk.size();
+    appendVarint(chunk, names.size());
+    for(const auto &name: names)
+    {
+        appendVarint(chunk, name.size());
+        chunk.append(name.data(), name.size());
+        if(chunk.size() >= CHUNK_SIZE) flush();
+    }
+    flush();
+
+    appendFixed(chunk, namesOffset, 8);
+    appendFixed(chunk, units, 8);
+    appendFixed(chunk, checksum, 4);
+    chunk.append(TRAILER_MAGIC, 4);
+    flush();
+
+    // buffered data is written on close.
+    file.close();
+    if(error || file.error() != QFileDevice::NoError) return fail();
+
+    return true;
+}
+
+//-----------------------------------------------------------------
+void Snapshot::import(sqlite3 *db) const
+{
+    const std::string insertQuery = "INSERT OR REPLACE INTO TASKS(TTIME, TNAME, TDURATION) VALUES (?1, ?2, ?3);";
+    sqlite3_stmt *insertStmt = nullptr;
+    int retValue = sqlite3_prepare_v2(db, insertQuery.c_str(), insertQuery.size(), &insertStmt, nullptr);
+    if (SQLITE_OK != retValue) {
+        const std::string message = std::string("Unable to prepare insert statement! Error: ") + std::to_string(retValue);
+        throw std::runtime_error(message.c_str());
+    }
+
+    // a single transaction, otherwise each insert is written to disk on its own.
+    if (SQLITE_OK != (retValue = sqlite3_exec(db, "BEGIN TRANSACTION;", nullptr, nullptr, nullptr))) {
+        sqlite3_finalize(insertStmt);
+        const std::string message = std::string("Unable to begin transaction! Error: ") + std::to_string(retValue);
+        throw std::runtime_error(message.c_str());
+    }
+
+    try
+    {
+        char time[24], duration[24];
+        forEach([&](const std::string_view name, const unsigned long long timeMs, const unsigned long long durationMs)
+        {
+            const auto timeEnd = std::to_chars(time, time + sizeof(time), timeMs).ptr;
+            const auto durationEnd = std::to_chars(duration, duration + sizeof(duration), durationMs).ptr;
+            sqlite3_bind_text(insertStmt, 1, time, timeEnd - time, SQLITE_STATIC);
+            sqlite3_bind_text(insertStmt, 2, name.data(), name.size(), SQLITE_STATIC);
+            sqlite3_bind_text(insertStmt, 3, duration, durationEnd - duration, SQLITE_STATIC);
+
+            if (SQLITE_DONE != (retValue = sqlite3_step(insertStmt))) {
+                const std::string message = std::string("Unable to insert data! Error: ") + std::to_string(retValue);
+                throw std::runtime_error(message.c_str());
+            }
+            sqlite3_reset(insertStmt);
+        });
+    }
+    catch(...)
+    {
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        sqlite3_finalize(insertStmt);
+        throw;
+    }
+
+    sqlite3_finalize(insertStmt);
+
+    if (SQLITE_OK != (retValue = sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr))) {
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        const std::string message = std::string("Unable to commit the imported units! Error: ") + std::to_string(retValue);
+        throw std::runtime_error(message.c_str());
+    }
+}
@@ -0,0 +1,148 @@
+/*
+ File: Snapshot.h
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _SNAPSHOT_H_
+#define _SNAPSHOT_H_
+
+// Project
+#include <Utils.h>
+
+// Qt
+#include <QFile>
+
+// C++
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+/** \class Snapshot
+ * \brief Read-only view of a binary snapshot of the tasks. The file is memory mapped and checked
+ *        when opened, and the units are decoded when iterated.
+ *
+ *        Format, integers in little endian:
+ *        - Header: "WTSN" and the version, 2 bytes, followed by 2 reserved bytes.
+ *        - Units in time order: the time difference with the previous unit as a zigzag varint,
+ *          the task name index and the duration in milliseconds as varints.
+ *        - Names: the number of names and then the length and UTF-8 bytes of each one, in the order
+ *          of their first unit.
+ *        - Trailer: offset of the names and number of units, 8 bytes each, the CRC-32 of all the
+ *          previous bytes, 4 bytes, and "WTSE".
+ *
+ */
+class Snapshot
+{
+  public:
+    /** \brief Snapshot class constructor. Throws std::runtime_error if the file can't be read or it's not valid.
+     * \param[in] filename Filename of the snapshot on disk.
+     *
+     */
+    explicit Snapshot(const QString &filename);
+
+    /** \brief Snapshot class destructor.
+     *
+     */
+    ~Snapshot();
+
+    Snapshot(const Snapshot &) = delete;
+    Snapshot &operator=(const Snapshot &) = delete;
+
+    /** \brief Writes the tasks of the given days to a snapshot file on disk. Returns true on success.
+     * \param[in] filename Filename of the snapshot on disk.
+     * \param[in] config Application configuration that contains the database handle.
+     * \param[in] from First day of the tasks, null with a null last day for all the tasks.
+     * \param[in] to Last day of the tasks, null with a null first day for all the tasks.
+     * \param[in] progress Function called with the number of units written, the export is cancelled if it returns false.
+     *
+     */
+    static bool write(const QString &filename, Utils::Configuration &config, const QDateTime &from = QDateTime(),
+                      const QDateTime &to = QDateTime(), const Utils::ExportProgress &progress = Utils::ExportProgress());
+
+    /** \brief Returns the number of units of the snapshot.
+     *
+     */
+    unsigned long long size() const
+    { return m_units; }
+
+    /** \brief Returns the task names of the snapshot.
+     *
+     */
+    const std::vector<std::string_view> &names() const
+    { return m_names; }
+
+    /** \brief Calls the given function with the name, start time and duration of each unit, in time order.
+     * Throws std::runtime_error if the units are corrupted.
+     * \param[in] function Function to call.
+     *
+     */
+    template<class F> void forEach(F function) const
+    {
+        auto data = m_data + HEADER_SIZE;
+        const auto end = m_data + m_namesOffset;
+
+        unsigned long long time = 0;
+        for(unsigned long long i = 0; i < m_units; ++i)
+        {
+            const auto delta = readVarint(data, end);
+            time += static_cast<unsigned long long>((delta >> 1) ^ -(delta & 1));
+            const auto name = readVarint(data, end);
+            const auto duration = readVarint(data, end);
+            if(name >= m_names.size()) throw std::runtime_error("Invalid task name in snapshot!");
+
+            function(m_names[name], time, duration);
+        }
+    }
+
+    /** \brief Inserts the units of the snapshot in the database, replacing the units with the same start time.
+     * Throws std::runtime_error on database errors.
+     * \param[in] db Database handle.
+     *
+     */
+    void import(sqlite3 *db) const;
+
+  private:
+    /** \brief Returns the varint at the given position and moves the position after it. Throws
+     * std::runtime_error if it doesn't end before the given end.
+     * \param[inout] data Position of the varint.
+     * \param[in] end End of the data.
+     *
+     */
+    static unsigned long long readVarint(const uchar *&data, const uchar *end)
+    {
+        unsigned long long value = 0;
+        for(int shift = 0; data < end && shift < 64; shift += 7)
+        {
+            const auto byte = *data++;
+            value |= static_cast<unsigned long long>(byte & 0x7F) << shift;
+            if((byte & 0x80) == 0) return value;
+        }
+
+        throw std::runtime_error("Corrupted snapshot!");
+    }
+
+    static constexpr qint64 HEADER_SIZE = 8;   /** size of the header in bytes. */
+    static constexpr qint64 TRAILER_SIZE = 24; /** size of the trailer in bytes. */
+
+    QFile m_file;                          /** snapshot file. */
+    const uchar *m_data = nullptr;         /** mapped contents of the file. */
+    qint64 m_namesOffset = 0;              /** offset of the names. */
+    unsigned long long m_units = 0;        /** number of units. */
+    std::vector<std::string_view> m_names; /** task names, pointing to the mapped file. */
+};
+
+#endif // _SNAPSHOT_H_
@@ -0,0 +1,193 @@
+/*
+ File: Statistics.cpp
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <Statistics.h>
+
+// C++
+#include <algorithm>
+#include <cmath>
+
+constexpr unsigned long long MS_PER_MINUTE = 60 * 1000;
+
+//-----------------------------------------------------------------
+Statistics::Statistics()
+{
+    m_weekdayMs.fill(0);
+}
+
+//-----------------------------------------------------------------
+void Statistics::build(const Utils::TaskTableEntries &entries)
+{
+    clear();
+
+    for (const auto &entry : entries) {
+        if (entry.durationMs == 0) continue;
+
+        const auto name = QString::fromStdString(entry.name);
+        if (name != Utils::SHORT_BREAK && name != Utils::LONG_BREAK) {
+            const auto day = m_dayTable.day(entry.taskTime);
+            m_days[day] += entry.durationMs;
+            m_weekdayMs[QDate::fromJulianDay(day).dayOfWeek() - 1] += entry.durationMs;
+        }
+
+        updateLength(name, entry.durationMs);
+    }
+
+    // days are sorted, the streaks are computed in a single pass.
+    qint64 previous = 0;
+    unsigned int run = 0;
+    for (const auto &[day, durationMs] : m_days) {
+        run = (run != 0 && day == previous + 1) ? run + 1 : 1;
+        m_longestStreak = std::max(m_longestStreak, run);
+        previous = day;
+    }
+    m_lastStreak = run;
+
+    for (const auto &[name, lengths] : m_lengths) {
+        updatePercentiles(name);
+    }
+}
+
+//-----------------------------------------------------------------
+void Statistics::add(const QString &name, const unsigned long long timeMs, const unsigned long long durationMs,
+                     const unsigned long long addedMs)
+{
+    if (addedMs == 0) return;
+
+    if (name != Utils::SHORT_BREAK && name != Utils::LONG_BREAK) {
+        addWorkTime(m_dayTable.day(timeMs), addedMs);
+    }
+
+    // an updated unit replaces its previous length.
+    if (durationMs > addedMs) {
+        updateLength(name, durationMs - addedMs, true);
+    }
+    updateLength(name, durationMs);
+    updatePercentiles(name);
+}
+
+//-----------------------------------------------------------------
+void Statistics::clear()
+{
+    m_days.clear();
+    m_weekdayMs.fill(0);
+    m_longestStreak = 0;
+    m_lastStreak = 0;
+    m_lengths.clear();
+    m_taskStatistics.clear();
+}
+
+//-----------------------------------------------------------------
+unsigned int Statistics::currentStreak() const
+{
+    if (m_days.empty()) return 0;
+
+    // today counts as part of the streak even if there is no work yet.
+    const auto today = QDate::currentDate().toJulianDay();
+    return (m_days.rbegin()->first >= today - 1) ? m_lastStreak : 0;
+}
+
+//-----------------------------------------------------------------
+double Statistics::weekdayAverageHours(const int dayOfWeek) const
+{
+    if (m_days.empty() || dayOfWeek < 1 || dayOfWeek > 7) return 0;
+
+    const auto first = m_days.begin()->first;
+    const auto last = std::max(m_days.rbegin()->first, QDate::currentDate().toJulianDay());
+    const auto days = last - first + 1;
+
+    // number of days of the given day of the week in [first, last].
+    const auto offset = (dayOfWeek - QDate::fromJulianDay(first).dayOfWeek() + 7) % 7;
+    if (offset >= days) return 0;
+    const auto count = (days - offset - 1) / 7 + 1;
+
+    return static_cast<double>(m_weekdayMs[dayOfWeek - 1]) / (count * 3600 * 1000);
+}
+
+//-----------------------------------------------------------------
+void Statistics::addWorkTime(const qint64 day, const unsigned long long durationMs)
+{
+    m_weekdayMs[QDate::fromJulianDay(day).dayOfWeek() - 1] += durationMs;
+
+    auto it = m_days.find(day);
+    if (it != m_days.end()) {
+        it->second += durationMs;
+        return;
+    }
+
+    m_days[day] = durationMs;
+
+    // a new day joins the runs at both sides, usually just the one before.
+    unsigned int before = 0;
+    while (m_days.find(day - before - 1) != m_days.cend()) ++before;
+
+    unsigned int after = 0;
+    while (m_days.find(day + after + 1) != m_days.cend()) ++after;
+
+    const auto run = before + 1 + after;
+    m_longestStreak = std::max(m_longestStreak, run);
+
+    if (day + after == m_days.rbegin()->first) {
+        m_lastStreak = run;
+    }
+}
+
+//-----------------------------------------------------------------
+void Statistics::updateLength(const QString &name, const unsigned long long durationMs, const bool remove)
+{
+    const auto minutes = durationMs / MS_PER_MINUTE;
+    auto &lengths = m_lengths[name];
+    auto &stats = m_taskStatistics[name];
+
+    if (remove) {
+        if (minutes < lengths.size() && lengths[minutes] > 0) {
+            --lengths[minutes];
+            --stats.units;
+        }
+        return;
+    }
+
+    if (lengths.size() <= minutes) lengths.resize(minutes + 1, 0);
+    ++lengths[minutes];
+    ++stats.units;
+}
+
+//-----------------------------------------------------------------
+void Statistics::updatePercentiles(const QString &name)
+{
+    const auto &lengths = m_lengths[name];
+    auto &stats = m_taskStatistics[name];
+
+    const auto medianRank = static_cast<unsigned int>(std::ceil(stats.units * 0.5));
+    const auto p90Rank = static_cast<unsigned int>(std::ceil(stats.units * 0.9));
+
+    unsigned int accumulated = 0;
+    stats.medianMs = 0;
+    stats.p90Ms = 0;
+    for (size_t i = 0; i < lengths.size(); ++i) {
+        const auto previous = accumulated;
+        accumulated += lengths[i];
+        if (previous < medianRank && accumulated >= medianRank) stats.medianMs = i * MS_PER_MINUTE;
+        if (previous < p90Rank && accumulated >= p90Rank) {
+            stats.p90Ms = i * MS_PER_MINUTE;
+            break;
+        }
+    }
+}
@@ -0,0 +1,152 @@
+/*
+ File: Statistics.h
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _STATISTICS_H_
+#define _STATISTICS_H_
+
+// Project
+#include <Utils.h>
+#include <DayTable.h>
+
+// Qt
+#include <QString>
+
+// C++
+#include <array>
+#include <map>
+#include <vector>
+
+/** \class Statistics
+ * \brief Keeps the work statistics updated with each unit, so they can be read in constant time
+ *        regardless of the size of the history.
+ *
+ */
+class Statistics
+{
+  public:
+    /** \struct TaskStatistics
+     * \brief Statistics of the units of a task.
+     */
+    struct TaskStatistics
+    {
+        unsigned int units = 0;         /** number of units of the task. */
+        unsigned long long medianMs = 0; /** median unit length in milliseconds. */
+        unsigned long long p90Ms = 0;    /** 90th percentile of the unit length in milliseconds. */
+    };
+
+    /** \brief Statistics class constructor.
+     *
+     */
+    Statistics();
+
+    /** \brief Statistics class destructor.
+     *
+     */
+    ~Statistics()
+    {};
+
+    /** \brief Rebuilds the statistics from the given entries.
+     * \param[in] entries Task entries list.
+     *
+     */
+    void build(const Utils::TaskTableEntries &entries);
+
+    /** \brief Updates the statistics with an inserted or updated unit.
+     * \param[in] name Task name.
+     * \param[in] timeMs Start time of the unit in unix format.
+     * \param[in] durationMs Duration of the unit in milliseconds.
+     * \param[in] addedMs Milliseconds added to the unit, equal to the duration for new units.
+     *
+     */
+    void add(const QString &name, const unsigned long long timeMs, const unsigned long long durationMs,
+             const unsigned long long addedMs);
+
+    /** \brief Removes all the statistics.
+     *
+     */
+    void clear();
+
+    /** \brief Returns the number of consecutive days with work ending today or yesterday.
+     *
+     */
+    unsigned int currentStreak() const;
+
+    /** \brief Returns the longest number of consecutive days with work.
+     *
+     */
+    unsigned int longestStreak() const
+    { return m_longestStreak; }
+
+    /** \brief Returns the average hours of work of the given day of the week.
+     * \param[in] dayOfWeek Day of the week in [1,7], starting on monday.
+     *
+     */
+    double weekdayAverageHours(const int dayOfWeek) const;
+
+    /** \brief Returns the julian day the statistics assign to the given time.
+     * \param[in] timeMs Time in unix format.
+     *
+     */
+    qint64 day(const unsigned long long timeMs)
+    { return m_dayTable.day(timeMs); }
+
+    /** \brief Returns the work milliseconds of each julian day with work.
+     *
+     */
+    const std::map<qint64, unsigned long long> &days() const
+    { return m_days; }
+
+    /** \brief Returns the statistics of each task.
+     *
+     */
+    const std::map<QString, TaskStatistics> &tasks() const
+    { return m_taskStatistics; }
+
+  private:
+    /** \brief Adds work time to a day and updates the streaks.
+     * \param[in] day Julian day.
+     * \param[in] durationMs Milliseconds of work.
+     *
+     */
+    void addWorkTime(const qint64 day, const unsigned long long durationMs);
+
+    /** \brief Adds or removes a unit length from the distribution of a task.
+     * \param[in] name Task name.
+     * \param[in] durationMs Unit length in milliseconds.
+     * \param[in] remove True to remove the length and false to add it.
+     *
+     */
+    void updateLength(const QString &name, const unsigned long long durationMs, const bool remove = false);
+
+    /** \brief Recomputes the percentiles of a task from its distribution.
+     * \param[in] name Task name.
+     *
+     */
+    void updatePercentiles(const QString &name);
+
+    std::map<qint64, unsigned long long> m_days;               /** work milliseconds per julian day. */
+    std::array<unsigned long long, 7> m_weekdayMs;             /** work milliseconds per day of the week. */
+    unsigned int m_longestStreak = 0;                          /** longest run of days with work. */
+    unsigned int m_lastStreak = 0;                             /** run of days with work ending in the last day. */
+    std::map<QString, std::vector<unsigned int>> m_lengths;    /** unit lengths of each task, in minutes. */
+    std::map<QString, TaskStatistics> m_taskStatistics;        /** statistics of each task. */
+    DayTable m_dayTable;                                       /** local midnights to compute the day of a time. */
+};
+
+#endif
@@ -0,0 +1,170 @@
+/*
+ File: TaskCursor.cpp
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <TaskCursor.h>
+#include <DayTable.h>
+
+// C++
+#include <charconv>
+#include <stdexcept>
+#include <string>
+
+// SQLite
+extern "C"
+{
+#include <sqlite3/sqlite3.h>
+}
+
+//-----------------------------------------------------------------
+TaskCursor::TaskCursor(sqlite3 *db, const QDateTime &from, const QDateTime &to)
+: m_statement{prepare(db, "TTIME, TNAME, TDURATION", from, to)}
+{
+}
+
+//-----------------------------------------------------------------
+TaskCursor::TaskCursor(sqlite3 *db, const unsigned long long after, const unsigned long long before)
+: m_statement{prepare(db, "TTIME, TNAME, TDURATION", after, before)}
+{
+}
+
+//-----------------------------------------------------------------
+TaskCursor::~TaskCursor()
+{
+    sqlite3_finalize(m_statement);
+}
+
+//-----------------------------------------------------------------
+bool TaskCursor::next()
+{
+    const auto retValue = sqlite3_step(m_statement);
+    if (retValue == SQLITE_ROW) return true;
+    if (retValue == SQLITE_DONE) return false;
+
+    const std::string message = std::string("Unable to read tasks! Error: ") + std::to_string(retValue);
+    throw std::runtime_error(message.c_str());
+}
+
+//-----------------------------------------------------------------
+unsigned long long TaskCursor::timeMs() const
+{
+    const auto text = timeText();
+    unsigned long long value = 0;
+    std::from_chars(text.data(), text.data() + text.size(), value);
+
+    return value;
+}
+
+//-----------------------------------------------------------------
+unsigned long long TaskCursor::durationMs() const
+{
+    const auto text = durationText();
+    unsigned long long value = 0;
+    std::from_chars(text.data(), text.data() + text.size(), value);
+
+    return value;
+}
+
+//-----------------------------------------------------------------
+unsigned long long TaskCursor::count(sqlite3 *db, const QDateTime &from, const QDateTime &to)
+{
+    auto statement = prepare(db, "COUNT(*)", from, to);
+
+    unsigned long long result = 0;
+    if (sqlite3_step(statement) == SQLITE_ROW) result = sqlite3_column_int64(statement, 0);
+    sqlite3_finalize(statement);
+
+    return result;
+}
+
+//-----------------------------------------------------------------
+unsigned long long TaskCursor::count(sqlite3 *db, const unsigned long long after, const unsigned long long before)
+{
+    auto statement = prepare(db, "COUNT(*)", after, before);
+
+    unsigned long long result = 0;
+    if (sqlite3_step(statement) == SQLITE_ROW) result = sqlite3_column_int64(statement, 0);
+    sqlite3_finalize(statement);
+
+    return result;
+}
+
+//-----------------------------------------------------------------
+std::string_view TaskCursor::column(const int index) const
+{
+    const auto text = reinterpret_cast<const char *>(sqlite3_column_text(m_statement, index));
+    if (!text) return std::string_view();
+
+    return std::string_view(text, sqlite3_column_bytes(m_statement, index));
+}
+
+//-----------------------------------------------------------------
+sqlite3_stmt *TaskCursor::prepare(sqlite3 *db, const std::string &columns, const QDateTime &from, const QDateTime &to)
+{
+    // same days as Utils::tasksList, the times are text so the bounds are compared as text in the index.
+    const auto all = (from == QDateTime() && to == QDateTime());
+    std::string query = "SELECT " + columns + " FROM TASKS";
+    if (!all) query += " WHERE TTIME >= ?1 AND TTIME < ?2";
+    query += " ORDER BY TTIME;";
+
+    auto statement = prepare(db, query);
+    if (!all) {
+        // the end is the midnight after the last day, as in the histograms.
+        DayTable days{from.date(), to.date()};
+        const auto first = std::to_string(days.start(from.date().toJulianDay()));
+        const auto last = std::to_string(days.start(to.date().toJulianDay() + 1));
+        sqlite3_bind_text(statement, 1, first.c_str(), first.size(), SQLITE_TRANSIENT);
+        sqlite3_bind_text(statement, 2, last.c_str(), last.size(), SQLITE_TRANSIENT);
+    }
+
+    return statement;
+}
+
+//-----------------------------------------------------------------
+sqlite3_stmt *TaskCursor::prepare(sqlite3 *db, const std::string &columns, const unsigned long long after,
+                                  const unsigned long long before)
+{
+    std::string query = "SELECT " + columns + " FROM TASKS WHERE TTIME > ?1";
+    if (before != 0) query += " AND TTIME < ?2";
+    query += " ORDER BY TTIME;";
+
+    auto statement = prepare(db, query);
+
+    const auto first = std::to_string(after);
+    sqlite3_bind_text(statement, 1, first.c_str(), first.size(), SQLITE_TRANSIENT);
+    if (before != 0) {
+        const auto last = std::to_string(before);
+        sqlite3_bind_text(statement, 2, last.c_str(), last.size(), SQLITE_TRANSIENT);
+    }
+
+    return statement;
+}
+
+//-----------------------------------------------------------------
+sqlite3_stmt *TaskCursor::prepare(sqlite3 *db, const std::string &query)
+{
+    sqlite3_stmt *statement = nullptr;
+    int retValue = sqlite3_prepare_v2(db, query.c_str(), query.size(), &statement, nullptr);
+    if (SQLITE_OK != retValue) {
+        const std::string message = std::string("Unable to prepare tasks query! Error: ") + std::to_string(retValue);
+        throw std::runtime_error(message.c_str());
+    }
+
+    return statement;
+}
@@ -0,0 +1,154 @@
+/*
+ File: TaskCursor.h
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TASK_CURSOR_H_
+#define _TASK_CURSOR_H_
+
+// Qt
+#include <QDateTime>
+
+// C++
+#include <string_view>
+
+struct sqlite3;
+struct sqlite3_stmt;
+
+/** \class TaskCursor
+ * \brief Iterates the tasks of a range of days in time order with a prepared statement, so the
+ *        rows are read one at a time from the database instead of being stored in memory. The
+ *        values of the current row are valid until the next call to next().
+ *
+ */
+class TaskCursor
+{
+  public:
+    /** \brief TaskCursor class constructor. Throws std::runtime_error if the statement can't be prepared.
+     * \param[in] db Database handle.
+     * \param[in] from First day of the tasks, null with a null last day for all the tasks.
+     * \param[in] to Last day of the tasks, null with a null first day for all the tasks.
+     *
+     */
+    TaskCursor(sqlite3 *db, const QDateTime &from = QDateTime(), const QDateTime &to = QDateTime());
+
+    /** \brief TaskCursor class constructor for the tasks that start between the given times, both excluded.
+     * Throws std::runtime_error if the statement can't be prepared.
+     * \param[in] db Database handle.
+     * \param[in] after Start time in unix format, the tasks that start at this time are excluded.
+     * \param[in] before Start time in unix format, the tasks that start at this time are excluded. 0 for no limit.
+     *
+     */
+    TaskCursor(sqlite3 *db, const unsigned long long after, const unsigned long long before);
+
+    /** \brief TaskCursor class destructor.
+     *
+     */
+    ~TaskCursor();
+
+    TaskCursor(const TaskCursor &) = delete;
+    TaskCursor &operator=(const TaskCursor &) = delete;
+
+    /** \brief Moves to the next row. Returns true if there is a row and false at the end.
+     * Throws std::runtime_error on database errors.
+     *
+     */
+    bool next();
+
+    /** \brief Returns the text of the start time of the current row, in unix format.
+     *
+     */
+    std::string_view timeText() const
+    { return column(0); }
+
+    /** \brief Returns the task name of the current row, in UTF-8.
+     *
+     */
+    std::string_view name() const
+    { return column(1); }
+
+    /** \brief Returns the text of the duration of the current row, in milliseconds.
+     *
+     */
+    std::string_view durationText() const
+    { return column(2); }
+
+    /** \brief Returns the start time of the current row in unix format.
+     *
+     */
+    unsigned long long timeMs() const;
+
+    /** \brief Returns the duration of the current row in milliseconds.
+     *
+     */
+    unsigned long long durationMs() const;
+
+    /** \brief Returns the number of tasks in the given range of days.
+     * \param[in] db Database handle.
+     * \param[in] from First day of the tasks, null with a null last day for all the tasks.
+     * \param[in] to Last day of the tasks, null with a null first day for all the tasks.
+     *
+     */
+    static unsigned long long count(sqlite3 *db, const QDateTime &from = QDateTime(), const QDateTime &to = QDateTime());
+
+    /** \brief Returns the number of tasks that start between the given times, both excluded.
+     * \param[in] db Database handle.
+     * \param[in] after Start time in unix format, the tasks that start at this time are excluded.
+     * \param[in] before Start time in unix format, the tasks that start at this time are excluded. 0 for no limit.
+     *
+     */
+    static unsigned long long count(sqlite3 *db, const unsigned long long after, const unsigned long long before);
+
+  private:
+    /** \brief Returns the given column of the current row.
+     * \param[in] index Column index.
+     *
+     */
+    std::string_view column(const int index) const;
+
+    /** \brief Returns a statement for the given columns of the tasks in the given range of days.
+     * Throws std::runtime_error if the statement can't be prepared.
+     * \param[in] db Database handle.
+     * \param[in] columns Columns of the SELECT statement.
+     * \param[in] from First day of the tasks, null with a null last day for all the tasks.
+     * \param[in] to Last day of the tasks, null with a null first day for all the tasks.
+     *
+     */
+    static sqlite3_stmt *prepare(sqlite3 *db, const std::string &columns, const QDateTime &from, const QDateTime &to);
+
+    /** \brief Returns a statement for the given columns of the tasks that start between the given times, both
+     * excluded. Throws std::runtime_error if the statement can't be prepared.
+     * \param[in] db Database handle.
+     * \param[in] columns Columns of the SELECT statement.
+     * \param[in] after Start time in unix format, the tasks that start at this time are excluded.
+     * \param[in] before Start time in unix format, the tasks that start at this time are excluded. 0 for no limit.
+     *
+     */
+    static sqlite3_stmt *prepare(sqlite3 *db, const std::string &columns, const unsigned long long after,
+                                 const unsigned long long before);
+
+    /** \brief Returns the given query prepared. Throws std::runtime_error if it can't be prepared.
+     * \param[in] db Database handle.
+     * \param[in] query SQL query.
+     *
+     */
+    static sqlite3_stmt *prepare(sqlite3 *db, const std::string &query);
+
+    sqlite3_stmt *m_statement = nullptr; /** prepared select statement. */
+};
+
+#endif // _TASK_CURSOR_H_
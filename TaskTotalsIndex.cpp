@@ -0,0 +1,149 @@
+/*
+ File: TaskTotalsIndex.cpp
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <TaskTotalsIndex.h>
+
+// C++
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+//-----------------------------------------------------------------
+void TaskTotalsIndex::build(const Utils::TaskTableEntries &entries)
+{
+    clear();
+
+    if (entries.empty()) return;
+
+    std::vector<qint64> days;
+    days.reserve(entries.size());
+
+    qint64 first = std::numeric_limits<qint64>::max();
+    qint64 last = std::numeric_limits<qint64>::min();
+    for (const auto &entry : entries) {
+        const auto day = m_dayTable.day(entry.taskTime);
+        first = std::min(first, day);
+        last = std::max(last, day);
+        days.push_back(day);
+    }
+
+    m_firstDay = first;
+    m_days = last - first + 1;
+
+    // accumulate the time of each day and then compute the prefix sums once.
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const auto id = taskId(QString::fromStdString(entries[i].name));
+        m_prefix[id][days[i] - m_firstDay] += entries[i].durationMs;
+    }
+
+    for (auto &prefix : m_prefix) {
+        std::partial_sum(prefix.begin(), prefix.end(), prefix.begin());
+    }
+}
+
+//-----------------------------------------------------------------
+void TaskTotalsIndex::add(const QString &name, const unsigned long long timeMs, const unsigned long long durationMs)
+{
+    if (durationMs == 0) return;
+
+    const auto day = m_dayTable.day(timeMs);
+    reserveDay(day);
+
+    // units are usually added to the last day, so few positions need to be updated.
+    auto &prefix = m_prefix[taskId(name)];
+    for (auto i = day - m_firstDay; i < m_days; ++i) {
+        prefix[i] += durationMs;
+    }
+}
+
+//-----------------------------------------------------------------
+std::map<QString, unsigned long long> TaskTotalsIndex::totals(const QDateTime &from, const QDateTime &to) const
+{
+    std::map<QString, unsigned long long> result;
+    if (m_days == 0) return result;
+
+    const auto first = std::max<qint64>(from.date().toJulianDay() - m_firstDay, 0);
+    const auto last = std::min<qint64>(to.date().toJulianDay() - m_firstDay, m_days - 1);
+    if (first > last) return result;
+
+    for (size_t id = 0; id < m_names.size(); ++id) {
+        const auto value = cumulative(id, last) - cumulative(id, first - 1);
+        if (value != 0) result[m_names[id]] = value;
+    }
+
+    return result;
+}
+
+//-----------------------------------------------------------------
+void TaskTotalsIndex::clear()
+{
+    m_firstDay = 0;
+    m_days = 0;
+    m_names.clear();
+    m_ids.clear();
+    m_prefix.clear();
+}
+
+//-----------------------------------------------------------------
+size_t TaskTotalsIndex::taskId(const QString &name)
+{
+    const auto it = m_ids.find(name);
+    if (it != m_ids.cend()) return it->second;
+
+    const auto id = m_names.size();
+    m_names.push_back(name);
+    m_ids[name] = id;
+    m_prefix.emplace_back(m_days, 0);
+
+    return id;
+}
+
+//-----------------------------------------------------------------
+void TaskTotalsIndex::reserveDay(const qint64 day)
+{
+    if (m_days == 0) {
+        m_firstDay = day;
+        m_days = 1;
+        for (auto &prefix : m_prefix) prefix.assign(1, 0);
+        return;
+    }
+
+    if (day < m_firstDay) {
+        // no time before the first day, so the new positions are zero.
+        const auto extra = m_firstDay - day;
+        for (auto &prefix : m_prefix) prefix.insert(prefix.begin(), extra, 0);
+        m_firstDay = day;
+        m_days += extra;
+        return;
+    }
+
+    if (day >= m_firstDay + m_days) {
+        m_days = day - m_firstDay + 1;
+        for (auto &prefix : m_prefix) prefix.resize(m_days, prefix.back());
+    }
+}
+
+//-----------------------------------------------------------------
+unsigned long long TaskTotalsIndex::cumulative(const size_t id, const qint64 position) const
+{
+    if (position < 0) return 0;
+
+    return m_prefix[id][position];
+}
@@ -0,0 +1,114 @@
+/*
+ File: TaskTotalsIndex.h
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TASK_TOTALS_INDEX_H_
+#define _TASK_TOTALS_INDEX_H_
+
+// Project
+#include <Utils.h>
+#include <DayTable.h>
+
+// Qt
+#include <QString>
+
+// C++
+#include <map>
+#include <vector>
+
+/** \class TaskTotalsIndex
+ * \brief Per-task cumulative duration over the days of the database. The total time of a task
+ *        in any range of days is the difference of two values.
+ *
+ */
+class TaskTotalsIndex
+{
+  public:
+    /** \brief TaskTotalsIndex class constructor.
+     *
+     */
+    TaskTotalsIndex()
+    {};
+
+    /** \brief TaskTotalsIndex class destructor.
+     *
+     */
+    ~TaskTotalsIndex()
+    {};
+
+    /** \brief Builds the index from the contents of the database.
+     * \param[in] entries Task entries list.
+     *
+     */
+    void build(const Utils::TaskTableEntries &entries);
+
+    /** \brief Adds time to a task in the day of the given time.
+     * \param[in] name Task name.
+     * \param[in] timeMs Start time of the unit in unix format.
+     * \param[in] durationMs Milliseconds to add to the task.
+     *
+     */
+    void add(const QString &name, const unsigned long long timeMs, const unsigned long long durationMs);
+
+    /** \brief Returns the total time in milliseconds of each task with time in the given days.
+     * \param[in] from Start date.
+     * \param[in] to End date.
+     *
+     */
+    std::map<QString, unsigned long long> totals(const QDateTime &from, const QDateTime &to) const;
+
+    /** \brief Removes all the contents of the index.
+     *
+     */
+    void clear();
+
+    /** \brief Returns true if the index has no data and false otherwise.
+     *
+     */
+    bool isEmpty() const
+    { return m_names.empty(); }
+
+  private:
+    /** \brief Returns the identifier of the task, adding it if it doesn't exist.
+     * \param[in] name Task name.
+     *
+     */
+    size_t taskId(const QString &name);
+
+    /** \brief Grows the index so the given day is inside it.
+     * \param[in] day Julian day.
+     *
+     */
+    void reserveDay(const qint64 day);
+
+    /** \brief Returns the cumulative time of a task up to the given day position, inclusive.
+     * \param[in] id Task identifier.
+     * \param[in] position Position of the day in the index, -1 for none.
+     *
+     */
+    unsigned long long cumulative(const size_t id, const qint64 position) const;
+
+    qint64 m_firstDay = 0;                                  /** julian day of the first position of the index. */
+    qint64 m_days = 0;                                      /** number of days in the index. */
+    std::vector<QString> m_names;                           /** task names, by identifier. */
+    std::map<QString, size_t> m_ids;                        /** task name to identifier. */
+    std::vector<std::vector<unsigned long long>> m_prefix;  /** cumulative milliseconds of each task per day. */
+    DayTable m_dayTable;                                    /** local midnights to compute the day of a time. */
+};
+
+#endif
@@ -0,0 +1,92 @@
+/*
+ File: UnitsDialog.cpp
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <UnitsDialog.h>
+
+// Qt
+#include <QDateTime>
+#include <QDialogButtonBox>
+#include <QHeaderView>
+#include <QIcon>
+#include <QLabel>
+#include <QTableWidget>
+#include <QVBoxLayout>
+
+// C++
+#include <algorithm>
+
+//----------------------------------------------------------------------------
+UnitsDialog::UnitsDialog(const QDate &from, const QDate &to, Utils::TaskTableEntries entries, QWidget *parent, Qt::WindowFlags f)
+: QDialog{parent, f}
+{
+    setWindowIcon(QIcon(":/WorkTimer/clock.svg"));
+
+    const auto days = (from == to) ? from.toString("dd/MM/yyyy") : from.toString("dd/MM/yyyy") + " to " + to.toString("dd/MM/yyyy");
+    setWindowTitle("Units of " + days);
+
+    std::sort(entries.begin(), entries.end(), [](const auto &a, const auto &b) { return a.taskTime < b.taskTime; });
+
+    auto table = new QTableWidget(static_cast<int>(entries.size()), 4, this);
+    table->setHorizontalHeaderLabels({"Date", "Start", "Task", "Duration"});
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    table->verticalHeader()->setVisible(false);
+    table->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    table->horizontalHeader()->setSectionResizeMode(2, QHeaderView::Stretch);
+
+    unsigned long long totalMs = 0;
+    for(int row = 0; row < static_cast<int>(entries.size()); ++row)
+    {
+        const auto &entry = entries[row];
+        const auto start = QDateTime::fromMSecsSinceEpoch(entry.taskTime);
+        totalMs += entry.durationMs;
+
+        const QStringList texts{start.toString("dd/MM/yyyy"), start.toString("hh:mm:ss"), QString::fromStdString(entry.name),
+                                Utils::durationToString(entry.durationMs)};
+        for(int column = 0; column < texts.size(); ++column)
+        {
+            auto item = new QTableWidgetItem(texts[column]);
+            item->setTextAlignment(Qt::AlignCenter);
+            table->setItem(row, column, item);
+        }
+    }
+
+    setLayout(new QVBoxLayout());
+    layout()->addWidget(table);
+    layout()->addWidget(new QLabel(QString("%1 units - Total time: %2").arg(entries.size()).arg(Utils::durationToString(totalMs)), this));
+
+    auto buttonBox = new QDialogButtonBox(this);
+    buttonBox->setObjectName("buttonBox");
+    buttonBox->setOrientation(Qt::Orientation::Horizontal);
+    buttonBox->setStandardButtons(QDialogButtonBox::StandardButton::Ok);
+    layout()->addWidget(buttonBox);
+
+    QObject::connect(buttonBox, &QDialogButtonBox::accepted, this, qOverload<>(&QDialog::accept));
+    QObject::connect(buttonBox, &QDialogButtonBox::rejected, this, qOverload<>(&QDialog::reject));
+
+    resize(500, 400);
+}
+
+//----------------------------------------------------------------------------
+void UnitsDialog::showEvent(QShowEvent *e)
+{
+    QDialog::showEvent(e);
+    Utils::centerDialog(this);
+}
@@ -0,0 +1,58 @@
+/*
+ File: UnitsDialog.h
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _UNITS_DIALOG_H_
+#define _UNITS_DIALOG_H_
+
+// Project
+#include <Utils.h>
+
+// Qt
+#include <QDialog>
+
+/** \class UnitsDialog
+ * \brief Dialog that lists the units of a range of days.
+ *
+ */
+class UnitsDialog : public QDialog
+{
+    Q_OBJECT
+  public:
+    /** \brief UnitsDialog class constructor.
+     * \param[in] from First day of the units.
+     * \param[in] to Last day of the units.
+     * \param[in] entries Units of the days.
+     * \param[in] parent Raw pointer of the widget parent of this one.
+     * \param[in] f Window flags.
+     *
+     */
+    UnitsDialog(const QDate &from, const QDate &to, Utils::TaskTableEntries entries, QWidget *parent = nullptr,
+                Qt::WindowFlags f = Qt::WindowFlags());
+
+    /** \brief UnitsDialog class virtual destructor.
+     *
+     */
+    virtual ~UnitsDialog()
+    {};
+
+  protected:
+    void showEvent(QShowEvent *) override;
+};
+
+#endif // _UNITS_DIALOG_H_
@@ -19,6 +19,11 @@
 
 // Project
 #include <Utils.h>
+#include <DayTable.h>
+#include <TaskCursor.h>
+#include <BufferedWriter.h>
+#include <CsvFormatter.h>
+#include <CsvChunkWriter.h>
 
 // libxlsxwriter
 #include <xlsxwriter.h>
@@ -40,6 +45,9 @@
 // C++
 #include <iostream>
 #include <functional>
+#include <algorithm>
+#include <map>
+#include <numeric>
 #include <string>
 #include <stringapiset.h>
 
@@ -65,12 +73,26 @@ const QString SOUND_TIC_TAC = "Use continuous tic-tac";
 const QString ICON_MESSAGES = "Show tray icon messages";
 const QString DATA_DIRECTORY = "Data directory";
 const QString EXPORT_UNIXDATE = "Export unix date";
+const QString COMPRESSION_LEVEL = "Export compression level";
+const QString CHART_TASKS = "Tasks shown in charts";
+const QString PERFORMANCE_MODE = "Charts performance mode";
+const QString ANIMATION_LIMIT = "Animated chart elements limit";
 const QString VOICE_ANNOUNCEMENTS = "Voice announcements";
 const QString UNITS_PER_BREAK = "Number of work units before a long break";
 const QString GEOMETRY = "Application geometry";
 const QString STATE = "Application state";
+const QString EXPORT_WATERMARKS = "Export watermarks";
+const QString LIVE_UNIT_START = "Live unit start";
+
+const QString Utils::SHORT_BREAK = "Short break";
+const QString Utils::LONG_BREAK = "Long break";
 
 constexpr int DEFAULT_LOGICAL_DPI = 96;
+constexpr int DAILY_BUCKETS_MAX_DAYS = 62;   /** longest range that uses daily buckets. */
+constexpr int WEEKLY_BUCKETS_MAX_DAYS = 366; /** longest range that uses weekly buckets. */
+constexpr qint64 EXCEL_EPOCH_DAY = 2415019;  /** julian day of the day zero of Excel dates, 30/12/1899. */
+constexpr double MS_PER_DAY = 24 * 60 * 60 * 1000;
+constexpr unsigned long long PROGRESS_ROWS = 1024; /** rows written between calls to the export progress function. */
 
 //-----------------------------------------------------------------
 Utils::ClickableHoverLabel::ClickableHoverLabel(QWidget* parent, Qt::WindowFlags f) :
@@ -130,6 +152,10 @@ void Utils::Configuration::load()
     m_continuousTicTac = settings.value(SOUND_TIC_TAC, false).toBool();
     m_iconMessages = settings.value(ICON_MESSAGES, true).toBool();
     m_exportMs = settings.value(EXPORT_UNIXDATE, false).toBool();
+    m_chartTasks = settings.value(CHART_TASKS, 10).toInt();
+    m_compressionLevel = std::clamp(settings.value(COMPRESSION_LEVEL, 6).toInt(), 1, 9);
+    m_performanceMode = settings.value(PERFORMANCE_MODE, false).toBool();
+    m_animationLimit = settings.value(ANIMATION_LIMIT, 500).toInt();
     m_geometry = settings.value(GEOMETRY, QByteArray()).toByteArray();
     m_state = settings.value(STATE, QByteArray()).toByteArray();
 
@@ -176,12 +202,56 @@ void Utils::Configuration::save() const
     settings.setValue(SOUND_TIC_TAC, m_continuousTicTac);
     settings.setValue(ICON_MESSAGES, m_iconMessages);
     settings.setValue(EXPORT_UNIXDATE, m_exportMs);
+    settings.setValue(CHART_TASKS, m_chartTasks);
+    settings.setValue(COMPRESSION_LEVEL, m_compressionLevel);
+    settings.setValue(PERFORMANCE_MODE, m_performanceMode);
+    settings.setValue(ANIMATION_LIMIT, m_animationLimit);
     settings.setValue(GEOMETRY, m_geometry);
     settings.setValue(STATE, m_state);
 
     settings.sync();
 }
 
+//-----------------------------------------------------------------
+unsigned long long Utils::Configuration::exportWatermark(const QString &filename) const
+{
+    const QFileInfo info{filename};
+    if (!info.exists()) return 0;
+
+    // paths contain separators that QSettings uses for groups, so the key is the encoded path.
+    const auto key = QString::fromLatin1(info.absoluteFilePath().toUtf8().toHex());
+    QSettings settings = applicationSettings();
+    settings.beginGroup(EXPORT_WATERMARKS);
+    return settings.value(key, 0).toULongLong();
+}
+
+//-----------------------------------------------------------------
+void Utils::Configuration::setExportWatermark(const QString &filename, const unsigned long long timeMs) const
+{
+    const auto key = QString::fromLatin1(QFileInfo{filename}.absoluteFilePath().toUtf8().toHex());
+    QSettings settings = applicationSettings();
+    settings.beginGroup(EXPORT_WATERMARKS);
+    if(timeMs == 0)
+        settings.remove(key);
+    else
+        settings.setValue(key, timeMs);
+    settings.sync();
+}
+
+//-----------------------------------------------------------------
+unsigned long long Utils::Configuration::liveUnitStart() const
+{
+    return applicationSettings().value(LIVE_UNIT_START, 0).toULongLong();
+}
+
+//-----------------------------------------------------------------
+void Utils::Configuration::setLiveUnitStart(const unsigned long long timeMs) const
+{
+    QSettings settings = applicationSettings();
+    settings.setValue(LIVE_UNIT_START, timeMs);
+    settings.sync();
+}
+
 //-----------------------------------------------------------------
 QSettings Utils::Configuration::applicationSettings() const
 {
@@ -221,7 +291,7 @@ void Utils::Configuration::openDatabase()
     const auto dbFilename = QDir{m_dataDir}.absoluteFilePath("worktimer.db");
 
     if (SQLITE_OK != (retValue = sqlite3_open_v2(dbFilename.toStdString().c_str(), &m_database,
-                                                 SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, nullptr))) {
+                                                 SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_FULLMUTEX, nullptr))) {
         const std::string message = std::string("Unable to open SQLite database! Error: ") + std::to_string(retValue);
         throw std::runtime_error(message.c_str());
     }
@@ -299,13 +369,10 @@ Utils::TaskTableEntries Utils::tasksList(Utils::Configuration &config, const QDa
     if (from == QDateTime() && to == QDateTime()) {
         stmt = "SELECT * FROM TASKS;";
     } else {
-        auto beginning = from;
-        beginning.setTime(QTime{0, 0, 0});
-        auto ending = to;
-        ending.setTime(QTime{23, 59, 59});
-
-        stmt = "SELECT * FROM TASKS WHERE TTIME >= " + std::to_string(beginning.toMSecsSinceEpoch()) + " AND TTIME < " +
-               std::to_string(ending.toMSecsSinceEpoch()) + ";";
+        // the end is the midnight after the last day, as in the histograms.
+        DayTable days{from.date(), to.date()};
+        stmt = "SELECT * FROM TASKS WHERE TTIME >= " + std::to_string(days.start(from.date().toJulianDay())) + " AND TTIME < " +
+               std::to_string(days.start(to.date().toJulianDay() + 1)) + ";";
     }
 
     return tasksQuery(stmt, config);
@@ -323,79 +390,402 @@ QString Utils::toCamelCase(const QString& s)
 }
 
 //-----------------------------------------------------------------
-bool Utils::exportDataCSV(const QString& filename, const TaskTableEntries& entries, bool useMilliseconds) 
+QString Utils::durationToString(const unsigned long long durationMs)
+{
+    const auto seconds = durationMs / 1000;
+    return QString("%1:%2:%3").arg(seconds / 3600, 2, 10, QChar('0'))
+                              .arg((seconds / 60) % 60, 2, 10, QChar('0'))
+                              .arg(seconds % 60, 2, 10, QChar('0'));
+}
+
+//-----------------------------------------------------------------
+int Utils::compressionLevel(const QString &filename, const Configuration &config)
+{
+    return filename.endsWith(".gz", Qt::CaseInsensitive) ? config.m_compressionLevel : 0;
+}
+
+//-----------------------------------------------------------------
+bool Utils::exportDataCSV(const QString &filename, Configuration &config, const QDateTime &from, const QDateTime &to, bool useMilliseconds,
+                          const ExportProgress &progress)
+{
+    // the file is overwritten, a later append must start from scratch.
+    config.setExportWatermark(filename, 0);
+
+    // compressing runs in this thread while the chunks are formatted in the pool.
+    BufferedWriter file{filename, false, compressionLevel(filename, config)};
+    if(!file.isValid())
+        return false;
+
+    try
+    {
+        // rows are streamed from the database, only the chunks being formatted are in memory.
+        TaskCursor tasks{config.m_database, from, to};
+
+        CsvFormatter formatter{useMilliseconds};
+        formatter.appendHeader();
+        file.write(formatter.text());
+        formatter.clear();
+
+        // formatting is the slowest part, the rows are formatted in parallel and written in order.
+        CsvChunkWriter writer{file, useMilliseconds};
+
+        unsigned long long rows = 0;
+        while(tasks.next())
+        {
+            writer.append(tasks.timeMs(), tasks.name(), tasks.durationMs());
+
+            if(progress && (++rows % PROGRESS_ROWS == 0) && !progress(rows)) return false;
+        }
+        writer.finish();
+    }
+    catch(const std::runtime_error &e)
+    {
+        std::cerr << "Error exporting tasks [" << e.what() << "]\n";
+        return false;
+    }
+
+    return file.close();
+}
+
+//-----------------------------------------------------------------
+bool Utils::appendDataCSV(const QString &filename, Configuration &config, bool useMilliseconds, const ExportProgress &progress)
 {
-    QFile file{filename};
-    if(!file.open(QIODevice::WriteOnly|QIODevice::Text|QIODevice::Truncate))
+    // units are stored in time order, the ones after the last exported unit haven't been exported yet.
+    const auto watermark = config.exportWatermark(filename);
+    const auto append = watermark != 0;
+
+    // the units already in a file without a watermark are unknown, appending would duplicate or lose them.
+    if(!append && QFileInfo::exists(filename))
+    {
+        std::cerr << "Error appending tasks [" << filename.toStdString() << " wasn't created by an append export]\n";
         return false;
+    }
+    const auto size = append ? QFileInfo{filename}.size() : 0;
 
-    const QString header("Date,Task name,Duration\n");
-    file.write(header.toUtf8());
-    for(const auto &task: entries)
+    auto last = watermark;
+    bool exported = false;
     {
-        if (!useMilliseconds) {
-            const auto startTime = QDateTime::fromMSecsSinceEpoch(task.taskTime);
-            const auto duration = QTime{0, 0, 0}.addMSecs(task.durationMs);
-            const auto line = QString("%1,\"%2\",%3\n")
-                                  .arg(startTime.toString())
-                                  .arg(QString::fromStdString(task.name))
-                                  .arg(duration.toString("hh::mm::ss"));
-            file.write(line.toUtf8());
-        } else {
-            const auto line = QString("%1,\"%2\",%3\n")
-                                  .arg(task.taskTime)
-                                  .arg(QString::fromStdString(task.name))
-                                  .arg(task.durationMs);
-            file.write(line.toUtf8());
+        BufferedWriter file{filename, append, compressionLevel(filename, config)};
+        if(!file.isValid())
+            return false;
+
+        try
+        {
+            // the watermark can't pass a unit that will still change, it would never be exported again.
+            TaskCursor tasks{config.m_database, watermark, config.liveUnitStart()};
+
+            CsvFormatter formatter{useMilliseconds};
+            if(!append)
+            {
+                formatter.appendHeader();
+                file.write(formatter.text());
+                formatter.clear();
+            }
+
+            CsvChunkWriter writer{file, useMilliseconds};
+
+            unsigned long long rows = 0;
+            bool cancelled = false;
+            while(!cancelled && tasks.next())
+            {
+                writer.append(tasks.timeMs(), tasks.name(), tasks.durationMs());
+                last = tasks.timeMs();
+
+                cancelled = progress && (++rows % PROGRESS_ROWS == 0) && !progress(rows);
+            }
+
+            if(!cancelled) writer.finish();
+            exported = file.close() && !cancelled;
+        }
+        catch(const std::runtime_error &e)
+        {
+            std::cerr << "Error exporting tasks [" << e.what() << "]\n";
         }
     }
 
-    file.flush();
-    file.close();
+    // the rows appended before the error are removed, otherwise the next export would repeat them.
+    if(!exported)
+    {
+        if(append) QFile::resize(filename, size);
+        else QFile::remove(filename);
+        return false;
+    }
+
+    // a new file without units still needs a watermark, or the next appends would refuse it. Times
+    // are compared as text and every stored time is greater than "1".
+    if(!append && last == 0) last = 1;
+
+    if(last != watermark) config.setExportWatermark(filename, last);
 
     return true;
 }
 
 //-----------------------------------------------------------------
-bool Utils::exportDataExcel(const QString& filename, const TaskTableEntries& entries, bool useMilliseconds) 
+double Utils::excelDateTime(DayTable &days, const unsigned long long timeMs)
+{
+    const auto day = days.day(timeMs);
+    const auto start = days.start(day);
+
+    // the time of the day can't be computed from the midnight when the clock changes.
+    if(days.start(day + 1) - start != MS_PER_DAY)
+    {
+        const auto time = QDateTime::fromMSecsSinceEpoch(timeMs).time();
+        return (day - EXCEL_EPOCH_DAY) + time.msecsSinceStartOfDay() / MS_PER_DAY;
+    }
+
+    return (day - EXCEL_EPOCH_DAY) + (timeMs - start) / MS_PER_DAY;
+}
+
+//-----------------------------------------------------------------
+bool Utils::exportDataExcel(const QString &filename, Configuration &config, const QDateTime &from, const QDateTime &to, bool useMilliseconds,
+                            const ExportProgress &progress)
 {
-    lxw_workbook  *workbook  = workbook_new(filename.toStdString().c_str());
+    // the file is overwritten, a later append must start from scratch.
+    config.setExportWatermark(filename, 0);
+
+    // rows are written to disk as they are added instead of keeping the whole sheet in memory.
+    lxw_workbook_options options{};
+    options.constant_memory = LXW_TRUE;
+
+    lxw_workbook *workbook = workbook_new_opt(filename.toStdString().c_str(), &options);
     if(!workbook)
         return false;
 
     lxw_worksheet *worksheet = workbook_add_worksheet(workbook, nullptr);
     if(!worksheet)
+    {
+        workbook_close(workbook);
         return false;
+    }
 
     /* Change the columns width for clarity. */
     worksheet_set_column(worksheet, 0, 0, 40, nullptr);
     worksheet_set_column(worksheet, 1, 1, 40, nullptr);
     worksheet_set_column(worksheet, 2, 2, 12, nullptr);
 
-    const auto start = QDateTime::fromMSecsSinceEpoch(entries.front().taskTime);
-    const auto ending = QDateTime::fromMSecsSinceEpoch(entries.back().taskTime);
-    const std::string header = start.toString().toStdString() + " to " + ending.toString().toStdString();
-    worksheet_set_header(worksheet, header.c_str());
+    // formats are created once and shared by all the cells.
+    lxw_format *headerFormat = workbook_add_format(workbook);
+    format_set_bold(headerFormat);
+    lxw_format *dateFormat = workbook_add_format(workbook);
+    format_set_num_format(dateFormat, "dd/mm/yyyy hh:mm:ss");
+    lxw_format *durationFormat = workbook_add_format(workbook);
+    format_set_num_format(durationFormat, "[h]:mm:ss");
+
+    worksheet_write_string(worksheet, 0, 0, "Date", headerFormat);
+    worksheet_write_string(worksheet, 0, 1, "Task name", headerFormat);
+    worksheet_write_string(worksheet, 0, 2, "Duration", headerFormat);
+
+    lxw_row_t row = 1;
+    unsigned long long first = 0, last = 0;
+    try
+    {
+        TaskCursor tasks{config.m_database, from, to};
+        DayTable days;
+
+        while(tasks.next())
+        {
+            const auto timeMs = tasks.timeMs();
+            if(row == 1) first = timeMs;
+            last = timeMs;
+
+            // sqlite texts are null terminated.
+            if (!useMilliseconds) {
+                worksheet_write_number(worksheet, row, 0, excelDateTime(days, timeMs), dateFormat);
+                worksheet_write_string(worksheet, row, 1, tasks.name().data(), nullptr);
+                worksheet_write_number(worksheet, row, 2, static_cast<double>(tasks.durationMs()) / MS_PER_DAY, durationFormat);
+            } else {
+                worksheet_write_number(worksheet, row, 0, timeMs, nullptr);
+                worksheet_write_string(worksheet, row, 1, tasks.name().data(), nullptr);
+                worksheet_write_number(worksheet, row, 2, tasks.durationMs(), nullptr);
+            }
+            ++row;
+
+            if(progress && (row - 1) % PROGRESS_ROWS == 0 && !progress(row - 1))
+            {
+                workbook_close(workbook);
+                return false;
+            }
+        }
+    }
+    catch(const std::runtime_error &e)
+    {
+        std::cerr << "Error exporting tasks [" << e.what() << "]\n";
+        workbook_close(workbook);
+        return false;
+    }
 
-    int i = 0; 
-    for(const auto &task: entries)
+    if(row > 1)
     {
-        if (!useMilliseconds) {
-            auto taskTime = QDateTime::fromMSecsSinceEpoch(task.taskTime);
-            worksheet_write_string(worksheet, i, 0, taskTime.toString().toStdString().c_str(), nullptr);
-            worksheet_write_string(worksheet, i, 1, task.name.c_str(), nullptr);
-            auto taskDuration = QTime{0, 0, 0}.addMSecs(task.durationMs);
-            worksheet_write_string(worksheet, i++, 2, taskDuration.toString("hh:mm:ss").toStdString().c_str(), nullptr);
-        } else {
-            worksheet_write_number(worksheet, i, 0, task.taskTime, nullptr);
-            worksheet_write_string(worksheet, i, 1, task.name.c_str(), nullptr);
-            worksheet_write_number(worksheet, i++, 2, task.durationMs, nullptr);
+        const auto start = QDateTime::fromMSecsSinceEpoch(first);
+        const auto ending = QDateTime::fromMSecsSinceEpoch(last);
+        const std::string header = start.toString().toStdString() + " to " + ending.toString().toStdString();
+        worksheet_set_header(worksheet, header.c_str());
+    }
+
+    return workbook_close(workbook) == LXW_NO_ERROR;
+}
+
+//-----------------------------------------------------------------
+bool Utils::exportReportExcel(const QString &filename, Configuration &config, const QDateTime &from, const QDateTime &to,
+                              const ExportProgress &progress)
+{
+    // the file is overwritten, a later append must start from scratch.
+    config.setExportWatermark(filename, 0);
+
+    lxw_workbook_options options{};
+    options.constant_memory = LXW_TRUE;
+
+    lxw_workbook *workbook = workbook_new_opt(filename.toStdString().c_str(), &options);
+    if(!workbook)
+        return false;
+
+    lxw_worksheet *unitsSheet = workbook_add_worksheet(workbook, "Units");
+    lxw_worksheet *dailySheet = workbook_add_worksheet(workbook, "Daily");
+    lxw_worksheet *summarySheet = workbook_add_worksheet(workbook, "Summary");
+    if(!unitsSheet || !dailySheet || !summarySheet)
+    {
+        workbook_close(workbook);
+        return false;
+    }
+
+    lxw_format *headerFormat = workbook_add_format(workbook);
+    format_set_bold(headerFormat);
+    lxw_format *dateTimeFormat = workbook_add_format(workbook);
+    format_set_num_format(dateTimeFormat, "dd/mm/yyyy hh:mm:ss");
+    lxw_format *dateFormat = workbook_add_format(workbook);
+    format_set_num_format(dateFormat, "dd/mm/yyyy");
+    lxw_format *durationFormat = workbook_add_format(workbook);
+    format_set_num_format(durationFormat, "[h]:mm:ss");
+    lxw_format *percentFormat = workbook_add_format(workbook);
+    format_set_num_format(percentFormat, "0.00%");
+
+    worksheet_set_column(unitsSheet, 0, 1, 40, nullptr);
+    worksheet_set_column(unitsSheet, 2, 2, 12, nullptr);
+    worksheet_write_string(unitsSheet, 0, 0, "Date", headerFormat);
+    worksheet_write_string(unitsSheet, 0, 1, "Task name", headerFormat);
+    worksheet_write_string(unitsSheet, 0, 2, "Duration", headerFormat);
+
+    // the units are written as they are read, the other sheets only need the time of each task on each day
+    // since the first one, and its number of units.
+    std::map<std::string, size_t, std::less<>> ids;
+    std::vector<std::string_view> names;
+    std::vector<std::vector<unsigned long long>> dailyMs;
+    std::vector<unsigned long long> taskMs, taskUnits;
+    qint64 firstDay = 0;
+    size_t dayCount = 0;
+
+    lxw_row_t row = 1;
+    try
+    {
+        TaskCursor tasks{config.m_database, from, to};
+        DayTable days;
+
+        while(tasks.next())
+        {
+            const auto timeMs = tasks.timeMs();
+            const auto durationMs = tasks.durationMs();
+            const auto name = tasks.name();
+
+            worksheet_write_number(unitsSheet, row, 0, excelDateTime(days, timeMs), dateTimeFormat);
+            worksheet_write_string(unitsSheet, row, 1, name.data(), nullptr);
+            worksheet_write_number(unitsSheet, row, 2, static_cast<double>(durationMs) / MS_PER_DAY, durationFormat);
+
+            // rows come in time order, so the days only grow at the end.
+            const auto day = days.day(timeMs);
+            if(row == 1) firstDay = day;
+            dayCount = std::max<size_t>(dayCount, day - firstDay + 1);
+
+            auto id = ids.find(name);
+            if(id == ids.end())
+            {
+                id = ids.emplace(std::string(name), names.size()).first;
+                names.push_back(id->first);
+                dailyMs.emplace_back();
+                taskMs.push_back(0);
+                taskUnits.push_back(0);
+            }
+
+            auto &taskDays = dailyMs[id->second];
+            if(taskDays.size() < dayCount) taskDays.resize(dayCount, 0);
+            taskDays[day - firstDay] += durationMs;
+            taskMs[id->second] += durationMs;
+            ++taskUnits[id->second];
+            ++row;
+
+            if(progress && (row - 1) % PROGRESS_ROWS == 0 && !progress(row - 1))
+            {
+                workbook_close(workbook);
+                return false;
+            }
         }
     }
+    catch(const std::runtime_error &e)
+    {
+        std::cerr << "Error exporting tasks [" << e.what() << "]\n";
+        workbook_close(workbook);
+        return false;
+    }
 
-    workbook_close(workbook);
+    // Daily sheet, a row per day and a column per task.
+    const auto columns = static_cast<lxw_col_t>(std::min<size_t>(names.size(), LXW_COL_MAX - 2));
+    if(columns < names.size())
+        std::cerr << "Warning exporting tasks [only " << columns << " of " << names.size() << " tasks fit in the Daily sheet, the totals include all]\n";
+    worksheet_set_column(dailySheet, 0, 0, 12, nullptr);
+    worksheet_set_column(dailySheet, 1, columns + 1, 14, nullptr);
+    worksheet_write_string(dailySheet, 0, 0, "Date", headerFormat);
+    for(lxw_col_t column = 0; column < columns; ++column)
+    {
+        const std::string name{names[column]};
+        worksheet_write_string(dailySheet, 0, column + 1, name.c_str(), headerFormat);
+    }
+    worksheet_write_string(dailySheet, 0, columns + 1, "Total", headerFormat);
 
-    return true;
+    for(size_t day = 0; day < dayCount; ++day)
+    {
+        const auto dayRow = static_cast<lxw_row_t>(day + 1);
+        worksheet_write_number(dailySheet, dayRow, 0, static_cast<double>(firstDay + static_cast<qint64>(day) - EXCEL_EPOCH_DAY), dateFormat);
+
+        // the total is of all the tasks, also the ones without a column, so it matches the Summary sheet.
+        unsigned long long totalMs = 0;
+        for(size_t task = 0; task < names.size(); ++task)
+        {
+            const auto &taskDays = dailyMs[task];
+            if(day >= taskDays.size() || taskDays[day] == 0) continue;
+
+            if(task < columns)
+                worksheet_write_number(dailySheet, dayRow, static_cast<lxw_col_t>(task + 1), static_cast<double>(taskDays[day]) / MS_PER_DAY, durationFormat);
+            totalMs += taskDays[day];
+        }
+        worksheet_write_number(dailySheet, dayRow, columns + 1, static_cast<double>(totalMs) / MS_PER_DAY, durationFormat);
+    }
+
+    // Summary sheet, tasks sorted by time.
+    std::vector<size_t> order(names.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&taskMs](const size_t a, const size_t b) { return taskMs[a] > taskMs[b]; });
+    const auto totalMs = std::accumulate(taskMs.cbegin(), taskMs.cend(), 0ULL);
+
+    worksheet_set_column(summarySheet, 0, 0, 40, nullptr);
+    worksheet_set_column(summarySheet, 1, 4, 14, nullptr);
+    const char *headers[] = {"Task name", "Units", "Total time", "Average unit", "Percentage"};
+    for(lxw_col_t column = 0; column < 5; ++column)
+    {
+        worksheet_write_string(summarySheet, 0, column, headers[column], headerFormat);
+    }
+
+    lxw_row_t summaryRow = 1;
+    for(const auto id: order)
+    {
+        const std::string name{names[id]};
+        worksheet_write_string(summarySheet, summaryRow, 0, name.c_str(), nullptr);
+        worksheet_write_number(summarySheet, summaryRow, 1, taskUnits[id], nullptr);
+        worksheet_write_number(summarySheet, summaryRow, 2, static_cast<double>(taskMs[id]) / MS_PER_DAY, durationFormat);
+        worksheet_write_number(summarySheet, summaryRow, 3, static_cast<double>(taskMs[id]) / taskUnits[id] / MS_PER_DAY, durationFormat);
+        worksheet_write_number(summarySheet, summaryRow, 4, totalMs == 0 ? 0 : static_cast<double>(taskMs[id]) / totalMs, percentFormat);
+        ++summaryRow;
+    }
+
+    return workbook_close(workbook) == LXW_NO_ERROR;
 }
 
 //-----------------------------------------------------------------
@@ -487,11 +877,10 @@ Utils::TaskTableEntries Utils::generateTestData(const QDateTime& from, const QDa
 //-----------------------------------------------------------------
 Utils::TaskDurationList Utils::taskNamesAndTimes(Utils::Configuration& config)
 {
-    std::map<QString, QTime> taskMap;
+    std::map<QString, unsigned long long> taskMap;
     for(auto &task: tasksList(config))
     {
-        const auto taskName = QString::fromStdString(task.name);
-        taskMap[taskName] = taskMap[taskName].addMSecs(task.durationMs);
+        taskMap[QString::fromStdString(task.name)] += task.durationMs;
     }
 
     Utils::TaskDurationList tasks;
@@ -501,54 +890,91 @@ Utils::TaskDurationList Utils::taskNamesAndTimes(Utils::Configuration& config)
         tasks.emplace_back(task.first, task.second);
     }
 
-    std::sort(tasks.begin(), tasks.end(), [](Utils::TaskDuration &lhs, Utils::TaskDuration &rhs){ return lhs.name < rhs.name;});
-
     return tasks;
 }
 
 //-----------------------------------------------------------------
-Utils::TaskHistogram Utils::taskHistogram(const QDateTime& from, const QDateTime& to, Utils::Configuration &config)
+Utils::Granularity Utils::histogramGranularity(const QDateTime& from, const QDateTime& to, const Granularity requested)
 {
-    auto beginning = from;
-    beginning.setTime(QTime{0,0,0});
-    auto ending = to;
-    ending.setTime(QTime{23,59,59});
+    if(requested != Granularity::AUTO)
+        return requested;
+
+    const auto days = from.date().daysTo(to.date()) + 1;
+    if(days <= DAILY_BUCKETS_MAX_DAYS)
+        return Granularity::DAY;
+
+    if(days <= WEEKLY_BUCKETS_MAX_DAYS)
+        return Granularity::WEEK;
+
+    return Granularity::MONTH;
+}
 
-    const std::string stmt = "SELECT * FROM TASKS WHERE TTIME >= " + std::to_string(beginning.toMSecsSinceEpoch()) + " AND TTIME < " + std::to_string(ending.toMSecsSinceEpoch()) + ";";
+//-----------------------------------------------------------------
+QDate Utils::nextBucket(const QDate& date, const Granularity granularity)
+{
+    switch(granularity)
+    {
+        case Granularity::WEEK:
+            return date.addDays(8 - date.dayOfWeek());
+        case Granularity::MONTH:
+            return QDate{date.year(), date.month(), 1}.addMonths(1);
+        default:
+        case Granularity::DAY:
+            break;
+    }
+
+    return date.addDays(1);
+}
+
+//-----------------------------------------------------------------
+Utils::TaskHistogram Utils::taskHistogram(const QDateTime& from, const QDateTime& to, Utils::Configuration &config, const Granularity granularity)
+{
+    const auto firstDay = from.date().toJulianDay();
+    const auto lastDay = to.date().toJulianDay();
+    DayTable days{from.date(), to.date()};
+
+    const std::string stmt = "SELECT * FROM TASKS WHERE TTIME >= " + std::to_string(days.start(firstDay)) + " AND TTIME < " + std::to_string(days.start(lastDay + 1)) + ";";
 
     TaskHistogram result;
     const auto tasksQueried = tasksQuery(stmt, config);
-    if(tasksQueried.empty())
+    if(tasksQueried.empty() || lastDay < firstDay)
         return result;
 
-    TaskDurationList tasks;
-    std::map<QString, QTime> taskMap;
-    for(unsigned long long i = beginning.toMSecsSinceEpoch(); i < static_cast<unsigned long long>(ending.toMSecsSinceEpoch());)
-    {
-        beginning = beginning.addDays(1);
-        taskMap.clear();
-        tasks.clear();
+    const auto bucketSize = histogramGranularity(from, to, granularity);
 
-        for(auto &task: tasksQueried)
+    // start of each bucket and bucket of each day, the first bucket starts at the beginning of the range even if it's not aligned.
+    std::vector<unsigned long long> starts;
+    std::vector<size_t> dayBucket(lastDay - firstDay + 1);
+    for(auto bucket = from.date(); bucket.toJulianDay() <= lastDay;)
+    {
+        const auto next = nextBucket(bucket, bucketSize);
+        const auto end = std::min(next.toJulianDay(), lastDay + 1);
+        for(auto day = bucket.toJulianDay(); day < end; ++day)
         {
-            if(task.taskTime < i || task.taskTime > static_cast<unsigned long long>(beginning.toMSecsSinceEpoch())) continue;
-
-            const auto taskName = QString::fromStdString(task.name);
-            if(taskMap.find(taskName) == taskMap.cend())
-                taskMap[taskName] = QTime{0,0,0};
-
-            taskMap[taskName] = taskMap[taskName].addMSecs(task.durationMs);
+            dayBucket[day - firstDay] = starts.size();
         }
 
-        for (auto& task : taskMap) {
-            tasks.emplace_back(task.first, task.second);
-        }
+        starts.push_back(days.start(bucket.toJulianDay()));
+        bucket = next;
+    }
 
-        std::sort(tasks.begin(), tasks.end(),
-                  [](Utils::TaskDuration& lhs, Utils::TaskDuration& rhs) { return lhs.name < rhs.name; });
+    std::vector<std::map<QString, unsigned long long>> buckets(starts.size());
+    for(const auto &task: tasksQueried)
+    {
+        const auto day = days.day(task.taskTime) - firstDay;
+        if(day < 0 || day >= static_cast<qint64>(dayBucket.size())) continue;
 
-        result[i] = tasks;
-        i = beginning.toMSecsSinceEpoch();
+        buckets[dayBucket[day]][QString::fromStdString(task.name)] += task.durationMs;
+    }
+
+    // maps are ordered, so the tasks of each bucket are sorted by name.
+    for(size_t i = 0; i < starts.size(); ++i)
+    {
+        auto &tasks = result[starts[i]];
+        for(const auto &[name, durationMs]: buckets[i])
+        {
+            tasks.emplace_back(name, durationMs);
+        }
     }
 
     return result;
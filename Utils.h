@@ -28,11 +28,18 @@
 #include <QTime>
 #include <QDateTime>
 
+// C++
+#include <functional>
+
 class QDialog;
+class DayTable;
 struct sqlite3;
 
 namespace Utils
 {
+    extern const QString SHORT_BREAK; /** task name of the short break units. */
+    extern const QString LONG_BREAK;  /** task name of the long break units. */
+
     /** \class ClickableHoverLabel
     * \brief ClickableLabel subclass that changes the mouse cursor when hovered.
     *
@@ -120,6 +127,32 @@ namespace Utils
          */
         int minutesInSession() const;
 
+        /** \brief Returns the start time of the last unit exported to the given file, or 0 if the file
+         * doesn't exist or no units have been appended to it.
+         * \param[in] filename Filename of the exported file.
+         *
+         */
+        unsigned long long exportWatermark(const QString &filename) const;
+
+        /** \brief Stores the start time of the last unit exported to the given file.
+         * \param[in] filename Filename of the exported file.
+         * \param[in] timeMs Start time of the last exported unit in unix format.
+         *
+         */
+        void setExportWatermark(const QString &filename, const unsigned long long timeMs) const;
+
+        /** \brief Returns the start time of the unit that is still being updated by a running instance,
+         * or 0 if there is none. That unit and the later ones aren't appended to the exports yet.
+         *
+         */
+        unsigned long long liveUnitStart() const;
+
+        /** \brief Stores the start time of the unit that is still being updated, 0 if there is none.
+         * \param[in] timeMs Start time of the unit in unix format.
+         *
+         */
+        void setLiveUnitStart(const unsigned long long timeMs) const;
+
         int m_workUnitTime = 25;                      /** minutes of a work unit. */
         int m_shortBreakTime = 5;                     /** minutes of a short break. */
         int m_longBreakTime = 15;                     /** minutes of a long break. */
@@ -138,6 +171,10 @@ namespace Utils
         QString m_dataDir;                            /** directory that contains the database. */
         sqlite3* m_database = nullptr;                /** sqlite database. */
         bool m_exportMs = false;                      /** true to use milliseconds time when exporting data, or dates and duration if false. */
+        int m_compressionLevel = 6;                   /** gzip compression level of the .csv.gz exports in [1,9]. */
+        int m_chartTasks = 10;                        /** maximum number of tasks shown in the charts, the rest are grouped. */
+        bool m_performanceMode = false;               /** true to disable the chart animations and false otherwise. */
+        int m_animationLimit = 500;                   /** maximum number of chart elements to animate. */
         QByteArray m_geometry;                        /** application geometry. */
         QByteArray m_state;                           /** application state. */
 
@@ -203,15 +240,15 @@ namespace Utils
 
     struct TaskDuration
     {
-        QString name;   /** name of the task. */
-        QTime duration; /** task duration. */
+        QString name;                      /** name of the task. */
+        unsigned long long durationMs = 0; /** task duration in milliseconds. */
 
         /** \brief Struct TaskDuration empty constructor.
          * 
          */
         TaskDuration() :
             name{"Unknown"},
-            duration{QTime{0, 0, 0}} {};
+            durationMs{0} {};
 
         /** \brief Struct TaskDuration constructor.
          * \param[in] taskName Task name.
@@ -220,35 +257,55 @@ namespace Utils
          */
         TaskDuration(const QString& taskName, const unsigned long long& taskTimeMs) :
             name{taskName},
-            duration{QTime{0,0,0}.addMSecs(taskTimeMs)} {};
-
-        /** \brief Struct TaskDuration constructor.
-        * \param[in] taskName Task name.
-        * \param[in] taskTime Task duration time. 
-        * 
-        */
-        TaskDuration(const QString& taskName, const QTime& taskTime) :
-            name{taskName},
-            duration{taskTime} {};
-
+            durationMs{taskTimeMs} {};
     };
     using TaskDurationList = std::vector<TaskDuration>;
 
     using TaskHistogram = std::map<unsigned long long, TaskDurationList>;
 
+    /** \enum Granularity
+     * \brief Size of the buckets of a task histogram.
+     */
+    enum class Granularity : char
+    {
+        AUTO = 0, /** chosen from the length of the range. */
+        DAY,      /** one bucket per day. */
+        WEEK,     /** one bucket per week, starting on monday. */
+        MONTH     /** one bucket per month. */
+    };
+
+    /** \brief Returns the granularity of the histogram buckets for the given range. Returns the requested
+     * one unless it's AUTO, then it's selected from the number of days of the range.
+     * \param[in] from Start date.
+     * \param[in] to End date.
+     * \param[in] requested Requested granularity.
+     *
+     */
+    Granularity histogramGranularity(const QDateTime &from, const QDateTime &to, const Granularity requested = Granularity::AUTO);
+
+    /** \brief Returns the first day of the bucket that follows the one that contains the given date.
+     * \param[in] date Date inside a bucket.
+     * \param[in] granularity Size of the buckets, must not be AUTO.
+     *
+     */
+    QDate nextBucket(const QDate &date, const Granularity granularity);
+
     /** \brief Returns the task names and times of the database. 
      * \param[in] config Application configuration that contains the database handle.
      * 
      */
     TaskDurationList taskNamesAndTimes(Utils::Configuration &config);
 
-    /** \brief Returns the histogram of task for the given days interval.
+    /** \brief Returns the histogram of task for the given days interval. The keys are the start
+     * of each bucket in unix format.
      * \param[in] from Start date. 
      * \param[in] to End date.
      * \param[in] config Application configuration that contains the database handle.
+     * \param[in] granularity Size of the buckets of the histogram.
      *
      */
-    TaskHistogram taskHistogram(const QDateTime &from, const QDateTime &to, Utils::Configuration &config);
+    TaskHistogram taskHistogram(const QDateTime &from, const QDateTime &to, Utils::Configuration &config,
+                                const Granularity granularity = Granularity::AUTO);
 
     /** \brief SQLite table contents callback.
      * \param[inout] p_data Data conteiner pointer to insert the data of the table.
@@ -259,27 +316,86 @@ namespace Utils
      */
     int tasksTableCallback(void* p_data, int num_fields, char** p_fields, char** p_col_names);
 
+    /** \brief Returns the given duration as text in "hh:mm:ss" format, hours are not limited to a day.
+     * \param[in] durationMs Duration in milliseconds.
+     *
+     */
+    QString durationToString(const unsigned long long durationMs);
+
     /** \brief Helper method to return the camel case version of a given string.
      * \param[in] s String to transform.
      *
      */
     QString toCamelCase(const QString& s);
 
-    /** \brief Exports the given entries to a CSV file on disk with the given filename. Returns true on success.
+    /** \brief Function called during the exports with the number of rows written, returns false to cancel the export.
+     */
+    using ExportProgress = std::function<bool(unsigned long long)>;
+
+    /** \brief Returns the gzip compression level of the given export file, 0 if it isn't a .gz file.
      * \param[in] filename Filename of file on disk.
-     * \param[in] entries Task entries list. 
-     * \param[in] useMilliseconds True to export millisecond values and false to use text for times and dates. 
+     * \param[in] config Application configuration.
      *
      */
-    bool exportDataCSV(const QString &filename, const TaskTableEntries &entries, bool useMilliseconds);
+    int compressionLevel(const QString &filename, const Configuration &config);
 
-    /** \brief Exports the given entries to a Excel file on disk with the given filename. Returns true on success.
+    /** \brief Exports the tasks of the given days to a CSV file on disk with the given filename, compressed in
+     * gzip format if the filename ends in .gz. Returns true on success.
      * \param[in] filename Filename of file on disk.
-     * \param entries Task entries list. 
+     * \param[in] config Application configuration that contains the database handle.
+     * \param[in] from First day of the tasks.
+     * \param[in] to Last day of the tasks.
      * \param[in] useMilliseconds True to export millisecond values and false to use text for times and dates. 
+     * \param[in] progress Function called with the number of rows written, the export is cancelled if it returns false.
+     *
+     */
+    bool exportDataCSV(const QString &filename, Configuration &config, const QDateTime &from, const QDateTime &to, bool useMilliseconds,
+                       const ExportProgress &progress = ExportProgress());
+
+    /** \brief Appends the tasks added since the last call to a CSV file on disk with the given filename, compressed
+     * in gzip format if the filename ends in .gz. The unit that is still being updated and the later ones are
+     * left for a later call. All
+     * the tasks are exported if the file doesn't exist or it wasn't created with this method. The file is left
+     * unchanged if the export fails or it's cancelled. Returns true on success.
+     * \param[in] filename Filename of file on disk.
+     * \param[in] config Application configuration that contains the database handle.
+     * \param[in] useMilliseconds True to export millisecond values and false to use text for times and dates.
+     * \param[in] progress Function called with the number of rows written, the export is cancelled if it returns false.
+     *
+     */
+    bool appendDataCSV(const QString &filename, Configuration &config, bool useMilliseconds,
+                       const ExportProgress &progress = ExportProgress());
+
+    /** \brief Returns the given time as an Excel date, the days since 30/12/1899 in local time.
+     * \param[in] days Table of the local midnights.
+     * \param[in] timeMs Time in unix format.
+     *
+     */
+    double excelDateTime(DayTable &days, const unsigned long long timeMs);
+
+    /** \brief Exports the tasks of the given days to a Excel file on disk with the given filename. Returns true on success.
+     * \param[in] filename Filename of file on disk.
+     * \param[in] config Application configuration that contains the database handle.
+     * \param[in] from First day of the tasks.
+     * \param[in] to Last day of the tasks.
+     * \param[in] useMilliseconds True to export millisecond values and false to use Excel dates and durations.
+     * \param[in] progress Function called with the number of rows written, the export is cancelled if it returns false.
+     *
+     */
+    bool exportDataExcel(const QString &filename, Configuration &config, const QDateTime &from, const QDateTime &to, bool useMilliseconds,
+                         const ExportProgress &progress = ExportProgress());
+
+    /** \brief Exports the tasks of the given days to an Excel report with the units, the time of each task per day
+     * and a summary of each task. Returns true on success.
+     * \param[in] filename Filename of file on disk.
+     * \param[in] config Application configuration that contains the database handle.
+     * \param[in] from First day of the tasks.
+     * \param[in] to Last day of the tasks.
+     * \param[in] progress Function called with the number of rows written, the export is cancelled if it returns false.
      *
      */
-    bool exportDataExcel(const QString &filename, const TaskTableEntries &entries, bool useMilliseconds);
+    bool exportReportExcel(const QString &filename, Configuration &config, const QDateTime &from, const QDateTime &to,
+                           const ExportProgress &progress = ExportProgress());
 
     /** \brief Helper method to remove all row in a given table. 
      * \param[in] db Database pointer. 